@@ -0,0 +1,831 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <furi/furi.hpp>
+#include <furi/build.h>
+#include <furi/cache.h>
+#include <furi/router.h>
+#include <furi/store.h>
+#include <furi/suffix.h>
+#include "corpora.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#   define FURI_BENCH_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#   define FURI_BENCH_HAS_TSC 1
+#endif
+
+// usage: furi-bench [--out file.json] [--min-time ms] [--filter substring]
+// results are written as json (to stdout if no file is given)
+//
+// ns_per_uri is the time of the fastest pass over a corpus divided by the number of uris in it
+// bytes_per_cycle is the number of input bytes of a pass over the tsc cycles it took
+// (tsc cycles are at the nominal frequency of the cpu, so this is null on non-x86 targets)
+
+using namespace furi::capi;
+
+namespace
+{
+
+using bench_func = uint64_t (*)(const furi_sv* in, size_t n);
+
+uint64_t sum_sv(furi_sv sv)
+{
+    // avoid optimizing away the result
+    return uint64_t(uintptr_t(sv.begin)) + furi_sv_length(sv);
+}
+
+uint64_t b_split_uri(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_uri(in[i]);
+        sum += sum_sv(s.path) + sum_sv(s.query);
+    }
+    return sum;
+}
+
+uint64_t b_split_uri_scalar(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_uri_scalar(in[i]);
+        sum += sum_sv(s.path) + sum_sv(s.query);
+    }
+    return sum;
+}
+
+uint64_t b_split_uri_strict(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        furi_uri_violation v;
+        auto s = furi_split_uri_strict(in[i], &v);
+        sum += sum_sv(s.path) + sum_sv(s.query) + v.component;
+    }
+    return sum;
+}
+
+template <int Components>
+uint64_t b_split_uri_masked(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_uri_masked(in[i], Components);
+        sum += sum_sv(s.authority) + sum_sv(s.path);
+    }
+    return sum;
+}
+
+template <furi_sv (*Getter)(furi_sv)>
+uint64_t b_getter(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += sum_sv(Getter(in[i]));
+    }
+    return sum;
+}
+
+uint64_t b_split_authority(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_authority(in[i]);
+        sum += sum_sv(s.host) + sum_sv(s.port);
+    }
+    return sum;
+}
+
+uint64_t b_path_iter(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (auto pi = furi_make_path_iter_begin(in[i]); !furi_path_iter_is_done(pi); furi_path_iter_next(&pi))
+        {
+            sum += sum_sv(furi_path_iter_get_value(pi));
+        }
+    }
+    return sum;
+}
+
+uint64_t b_query_iter(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (auto qi = furi_make_query_iter_begin(in[i]); !furi_query_iter_is_done(qi); furi_query_iter_next(&qi))
+        {
+            auto kv = furi_query_iter_get_value(qi);
+            sum += sum_sv(kv.key) + sum_sv(kv.value);
+        }
+    }
+    return sum;
+}
+
+// keys a handler typically looks up in every query
+const furi_sv lookup_keys[] = {
+    furi_make_sv_from_string("id"),
+    furi_make_sv_from_string("page"),
+    furi_make_sv_from_string("utm_source"),
+    furi_make_sv_from_string("utm_campaign"),
+    furi_make_sv_from_string("session"),
+    furi_make_sv_from_string("missing"),
+};
+
+uint64_t b_query_lookup_iter(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (auto& key : lookup_keys)
+        {
+            for (auto qi = furi_make_query_iter_begin(in[i]); !furi_query_iter_is_done(qi); furi_query_iter_next(&qi))
+            {
+                auto kv = furi_query_iter_get_value(qi);
+                if (furi_sv_cmp(kv.key, key) == 0)
+                {
+                    sum += sum_sv(kv.value);
+                    break;
+                }
+            }
+        }
+    }
+    return sum;
+}
+
+uint64_t b_query_extract(const furi_sv* in, size_t n)
+{
+    constexpr uint32_t count = uint32_t(std::size(lookup_keys));
+    const auto filter = furi_make_query_key_filter(lookup_keys, count);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        furi_query_iter_value out[count];
+        furi_query_extract(in[i], lookup_keys, count, &filter, out);
+        for (auto& kv : out) sum += sum_sv(kv.value);
+    }
+    return sum;
+}
+
+uint64_t b_query_lookup_index(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    furi_query_index_storage storage;
+    std::vector<furi_query_index_item> big_items;
+    std::vector<furi_query_index_slot> big_slots;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto idx = furi_make_query_index_from_storage(&storage);
+        if (furi_sv_length(in[i]) > 8 * FURI_QUERY_INDEX_INLINE_CAPACITY)
+        {
+            // possibly too many items for the inline storage
+            uint32_t capacity = 1;
+            for (const char* p = in[i].begin; p != in[i].end; ++p) capacity += *p == FURI_QUERY_ITEM_SEP;
+            big_items.resize(capacity);
+            big_slots.resize(furi_query_index_slot_count(capacity));
+            idx = furi_make_query_index(big_items.data(), capacity, big_slots.data(), uint32_t(big_slots.size()));
+        }
+        furi_query_index_build(&idx, in[i]);
+        for (auto& key : lookup_keys)
+        {
+            auto item = furi_query_index_find(&idx, key);
+            if (item) sum += sum_sv(item->value);
+        }
+    }
+    return sum;
+}
+
+// a few hundred routes: "/a/b" and "/a/:id" for all pairs of path words and a static tail
+struct bench_routes
+{
+    std::vector<std::string> patterns;
+    std::vector<furi_router_node> nodes;
+    furi_router router;
+
+    bench_routes()
+    {
+        for (auto a : bench::path_words)
+        {
+            for (auto b : bench::path_words) patterns.push_back(std::string("/") + a + "/" + b);
+            patterns.push_back(std::string("/") + a + "/:id");
+        }
+        patterns.push_back("/static/*file");
+
+        uint32_t capacity = 1;
+        for (auto& p : patterns) capacity += furi_router_max_nodes(furi_make_sv(p.data(), p.data() + p.size()));
+        nodes.resize(capacity);
+        router = furi_make_router(nodes.data(), capacity);
+        for (size_t i = 0; i < patterns.size(); ++i)
+        {
+            auto& p = patterns[i];
+            furi_router_add(&router, furi_make_sv(p.data(), p.data() + p.size()), int(i));
+        }
+    }
+};
+
+const bench_routes& get_bench_routes()
+{
+    static const bench_routes routes;
+    return routes;
+}
+
+uint64_t b_router(const furi_sv* in, size_t n)
+{
+    auto& r = get_bench_routes().router;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto m = furi_router_match_path(&r, in[i]);
+        sum += uint64_t(m.route) + m.num_captures;
+    }
+    return sum;
+}
+
+// matching every pattern in turn
+bool linear_route_match(furi_sv pattern, furi_sv path)
+{
+    auto pi = furi_make_path_iter_begin(pattern);
+    auto si = furi_make_path_iter_begin(path);
+    for (; !furi_path_iter_is_done(pi); furi_path_iter_next(&pi), furi_path_iter_next(&si))
+    {
+        if (furi_path_iter_is_done(si)) return false;
+        auto p = furi_path_iter_get_value(pi);
+        auto s = furi_path_iter_get_value(si);
+        if (*p.begin == '*') return true;
+        if (*p.begin == ':') continue;
+        if (furi_sv_cmp(p, s) != 0) return false;
+    }
+    return furi_path_iter_is_done(si);
+}
+
+uint64_t b_router_linear(const furi_sv* in, size_t n)
+{
+    auto& patterns = get_bench_routes().patterns;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (furi_sv_is_empty(in[i])) continue;
+        for (size_t r = 0; r < patterns.size(); ++r)
+        {
+            auto& p = patterns[r];
+            if (linear_route_match(furi_make_sv(p.data(), p.data() + p.size()), in[i]))
+            {
+                sum += r;
+                break;
+            }
+        }
+    }
+    return sum;
+}
+
+// adding all uris to a store and reading the paths back through the handles
+uint64_t b_uri_store(const furi_sv* in, size_t n)
+{
+    static std::vector<furi_uri_store_entry> entries;
+    static std::vector<char> page;
+    entries.resize(n);
+    size_t bytes = 0;
+    for (size_t i = 0; i < n; ++i) bytes += furi_sv_length(in[i]);
+    page.resize(bytes);
+
+    furi_uri_store_page p;
+    auto store = furi_make_uri_store(entries.data(), uint32_t(n), &p, 1);
+    furi_uri_store_add_page(&store, page.data(), uint32_t(bytes));
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t h = 0;
+        furi_uri_store_add(&store, in[i], &h);
+        sum += h;
+    }
+    for (uint32_t h = 0; h < store.size; ++h)
+    {
+        sum += sum_sv(furi_uri_store_get(&store, h, FURI_URI_PATH));
+    }
+    return sum;
+}
+
+// rebuilding each uri from its split
+uint64_t b_build_uri(const furi_sv* in, size_t n)
+{
+    static std::string out;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_uri(in[i]);
+        furi_uri_parts p = {};
+        p.scheme = s.scheme;
+        p.authority = s.authority;
+        p.path = s.path;
+        p.query = s.query;
+        p.fragment = s.fragment;
+        out.resize(furi_build_uri_length(&p, false));
+        auto b = furi_build_uri(&p, out.data(), false);
+        sum += sum_sv(b.path);
+    }
+    return sum;
+}
+
+// the same with appends to an empty string
+uint64_t b_build_uri_append(const furi_sv* in, size_t n)
+{
+    auto append = [](std::string& str, furi_sv sv) { str.append(sv.begin, furi_sv_length(sv)); };
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_uri(in[i]);
+        std::string out;
+        if (s.scheme.begin) append(out, s.scheme), out += ':';
+        if (s.authority.begin) out += "//", append(out, s.authority);
+        append(out, s.path);
+        if (s.query.begin) out += '?', append(out, s.query);
+        if (s.fragment.begin) out += '#', append(out, s.fragment);
+        sum += out.size();
+    }
+    return sum;
+}
+
+bool bench_is_tracking(void*, furi_query_iter_value item)
+{
+    return furi_sv_starts_with(item.key, "utm_");
+}
+
+// removing tracking items and setting a key
+uint64_t b_query_edit(const furi_sv* in, size_t n)
+{
+    static std::vector<char> buf;
+    static const furi_sv remove[] = {furi_make_sv_from_string("fbclid"), furi_make_sv_from_string("gclid")};
+    static const furi_query_iter_value set[] = {{furi_make_sv_from_string("token"), furi_make_sv_from_string("secret")}};
+    furi_query_edit e = {};
+    e.remove_keys = remove;
+    e.num_remove_keys = 2;
+    e.remove_if = bench_is_tracking;
+    e.set = set;
+    e.num_set = 1;
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t max = furi_query_edit_max_length(in[i], &e);
+        if (buf.size() < max) buf.resize(max);
+        sum += sum_sv(furi_query_edit_apply(in[i], &e, buf.data()));
+    }
+    return sum;
+}
+
+// the same by collecting the items and joining them
+uint64_t b_query_edit_join(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::vector<std::pair<std::string, std::string>> items;
+        bool has_token = false;
+        for (auto qi = furi_make_query_iter_begin(in[i]); !furi_query_iter_is_done(qi); furi_query_iter_next(&qi))
+        {
+            auto v = furi_query_iter_get_value(qi);
+            std::string key(v.key.begin, furi_sv_length(v.key));
+            if (key == "fbclid" || key == "gclid" || key.compare(0, 4, "utm_") == 0) continue;
+            if (key == "token")
+            {
+                if (has_token) continue;
+                has_token = true;
+                items.emplace_back(key, "secret");
+                continue;
+            }
+            items.emplace_back(key, std::string(v.value.begin, furi_sv_length(v.value)));
+        }
+        if (!has_token) items.emplace_back("token", "secret");
+        std::string out;
+        for (auto& [k, v] : items)
+        {
+            if (!out.empty()) out += '&';
+            out += k;
+            out += '=';
+            out += v;
+        }
+        sum += out.size();
+    }
+    return sum;
+}
+
+// about 10k suffix rules: top level and second level public suffixes and many domains
+const std::vector<std::string>& bench_suffix_rules()
+{
+    static std::vector<std::string> ret;
+    if (!ret.empty()) return ret;
+    ret = {"com", "org", "net", "internal", "uk", "co.uk", "org.uk", "*.ck", "!www.ck"};
+    for (int i = 0; i < 10000; ++i) ret.push_back("d" + std::to_string(i) + (i % 2 ? ".example.com" : ".example.net"));
+    return ret;
+}
+
+uint64_t b_suffix_trie(const furi_sv* in, size_t n)
+{
+    static std::vector<furi_suffix_node> nodes;
+    static std::vector<char> chars;
+    static furi_suffix_trie trie = {};
+    if (!trie.num_nodes)
+    {
+        auto& strs = bench_suffix_rules();
+        std::vector<furi_sv> rules;
+        for (auto& r : strs) rules.push_back(furi_make_sv(r.data(), r.data() + r.size()));
+        auto num = uint32_t(rules.size());
+        std::vector<uint32_t> scratch(num);
+        nodes.resize(furi_suffix_trie_max_nodes(rules.data(), num));
+        chars.resize(furi_suffix_trie_max_chars(rules.data(), num));
+        furi_build_suffix_trie(rules.data(), num, scratch.data(),
+            nodes.data(), uint32_t(nodes.size()), chars.data(), uint32_t(chars.size()), &trie);
+    }
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto m = furi_suffix_trie_match(&trie, furi_get_host_from_authority(in[i]));
+        sum += sum_sv(m.domain) + m.rule;
+    }
+    return sum;
+}
+
+// the same by splitting the host into strings and probing a hash set with each suffix
+// (without wildcards and exceptions)
+uint64_t b_suffix_hash_set(const furi_sv* in, size_t n)
+{
+    static const std::unordered_set<std::string> rules(bench_suffix_rules().begin(), bench_suffix_rules().end());
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto host = furi_get_host_from_authority(in[i]);
+        std::vector<std::string> labels;
+        for (auto hi = furi_make_host_label_iter_begin(host); !furi_host_label_iter_is_done(hi); furi_host_label_iter_next(&hi))
+        {
+            auto l = furi_host_label_iter_get_value(hi);
+            labels.emplace_back(l.begin, furi_sv_length(l));
+            for (auto& c : labels.back()) c = furi_ascii_tolower(c);
+        }
+        std::string suffix, domain;
+        std::string cur;
+        for (size_t j = 0; j < labels.size(); ++j)
+        {
+            cur = j ? labels[j] + "." + cur : labels[j];
+            if (rules.count(cur))
+            {
+                suffix = cur;
+                domain = j + 1 < labels.size() ? labels[j + 1] + "." + cur : std::string();
+            }
+        }
+        sum += domain.size() + suffix.size();
+    }
+    return sum;
+}
+
+// the default port of the scheme of each uri
+uint64_t b_classify_scheme(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += furi_scheme_default_port(furi_classify_scheme(furi_split_uri_masked(in[i], FURI_URI_SCHEME).scheme));
+    }
+    return sum;
+}
+
+// the same with a chain of case-insensitive comparisons
+uint64_t b_scheme_compare(const furi_sv* in, size_t n)
+{
+    static const std::pair<const char*, uint16_t> schemes[] = {
+        {"http", 80}, {"https", 443}, {"ws", 80}, {"wss", 443}, {"ftp", 21}, {"ftps", 990}, {"sftp", 22}, {"ssh", 22},
+        {"file", 0}, {"git", 9418}, {"telnet", 23}, {"ldap", 389}, {"ldaps", 636}, {"gopher", 70}, {"rtsp", 554},
+        {"sip", 5060}, {"sips", 5061}, {"mqtt", 1883}, {"redis", 6379}, {"mailto", 0}, {"data", 0}, {"tel", 0}, {"urn", 0},
+    };
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto scheme = furi_split_uri_masked(in[i], FURI_URI_SCHEME).scheme;
+        for (auto& [name, port] : schemes)
+        {
+            if (furi_sv_iequals(scheme, furi_make_sv_from_string(name)))
+            {
+                sum += port;
+                break;
+            }
+        }
+    }
+    return sum;
+}
+
+// uppercase copies of the inputs, made on the first pass over them
+const std::vector<std::string>& bench_upper(const furi_sv* in, size_t n)
+{
+    static const furi_sv* cached = nullptr;
+    static std::vector<std::string> ret;
+    if (cached == in) return ret;
+    cached = in;
+    ret.assign(n, {});
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (const char* p = in[i].begin; p != in[i].end; ++p) ret[i] += (*p >= 'a' && *p <= 'z') ? char(*p - 32) : *p;
+    }
+    return ret;
+}
+
+uint64_t b_sv_iequals(const furi_sv* in, size_t n)
+{
+    auto& upper = bench_upper(in, n);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += furi_sv_iequals(in[i], furi_make_sv(upper[i].data(), upper[i].data() + upper[i].size()));
+    }
+    return sum;
+}
+
+// the same with a tolower loop
+uint64_t b_sv_iequals_tolower(const furi_sv* in, size_t n)
+{
+    auto& upper = bench_upper(in, n);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const char* a = in[i].begin;
+        const char* b = upper[i].data();
+        size_t len = furi_sv_length(in[i]);
+        if (len != upper[i].size()) continue;
+        size_t j = 0;
+        while (j < len && furi_ascii_tolower(a[j]) == furi_ascii_tolower(b[j])) ++j;
+        sum += j == len;
+    }
+    return sum;
+}
+
+furi_cache_key_config bench_cache_key_config()
+{
+    static const furi_sv deny[] = {furi_make_sv_from_string("fbclid"), furi_make_sv_from_string("gclid")};
+    furi_cache_key_config c = {};
+    c.components = FURI_URI_SCHEME | FURI_URI_AUTHORITY | FURI_URI_PATH | FURI_URI_QUERY;
+    c.filter = FURI_CACHE_KEY_DENY;
+    c.keys = deny;
+    c.num_keys = 2;
+    c.sort_query = true;
+    return c;
+}
+
+// hashing the sorted key without writing it
+uint64_t b_cache_key_hash(const furi_sv* in, size_t n)
+{
+    static furi_query_iter_value scratch[256];
+    auto c = bench_cache_key_config();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        furi_hash128 h = {};
+        furi_cache_key_hash(&c, in[i], scratch, 256, 0, &h);
+        sum += h.lo;
+    }
+    return sum;
+}
+
+// the same by sorting item strings, joining them, and hashing the key
+uint64_t b_cache_key_join(const furi_sv* in, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto s = furi_split_uri(in[i]);
+        std::string out;
+        if (s.scheme.begin) out.append(s.scheme.begin, furi_sv_length(s.scheme)), out += ':';
+        if (s.authority.begin) out += "//", out.append(s.authority.begin, furi_sv_length(s.authority));
+        out.append(s.path.begin, furi_sv_length(s.path));
+        std::vector<std::string> items;
+        for (auto qi = furi_make_query_iter_begin(s.query); !furi_query_iter_is_done(qi); furi_query_iter_next(&qi))
+        {
+            auto v = furi_query_iter_get_value(qi);
+            if (furi_sv_cmp(v.key, furi_make_sv_from_string("fbclid")) == 0) continue;
+            if (furi_sv_cmp(v.key, furi_make_sv_from_string("gclid")) == 0) continue;
+            items.emplace_back(v.key.begin, furi_sv_length(v.key));
+            if (v.value.begin) items.back().append(1, '=').append(v.value.begin, furi_sv_length(v.value));
+        }
+        std::sort(items.begin(), items.end());
+        for (size_t j = 0; j < items.size(); ++j)
+        {
+            out += j ? '&' : '?';
+            out += items[j];
+        }
+        sum += furi_hash(furi_make_sv(out.data(), out.data() + out.size()), 0).lo;
+    }
+    return sum;
+}
+
+enum class input
+{
+    uri,
+    authority,
+    path,
+    query,
+};
+
+struct benchmark
+{
+    const char* name;
+    input in;
+    bench_func func;
+};
+
+const benchmark benchmarks[] = {
+    {"furi_split_uri", input::uri, b_split_uri},
+    {"furi_split_uri_scalar", input::uri, b_split_uri_scalar},
+    {"furi_split_uri_strict", input::uri, b_split_uri_strict},
+    {"furi_split_uri_masked/authority", input::uri, b_split_uri_masked<FURI_URI_AUTHORITY>},
+    {"furi_split_uri_masked/path", input::uri, b_split_uri_masked<FURI_URI_PATH>},
+    {"furi_get_scheme_from_uri", input::uri, b_getter<furi_get_scheme_from_uri>},
+    {"furi_get_authority_from_uri", input::uri, b_getter<furi_get_authority_from_uri>},
+    {"furi_get_path_from_uri", input::uri, b_getter<furi_get_path_from_uri>},
+    {"furi_get_req_path_from_uri", input::uri, b_getter<furi_get_req_path_from_uri>},
+    {"furi_get_query_from_uri", input::uri, b_getter<furi_get_query_from_uri>},
+    {"furi_get_fragment_from_uri", input::uri, b_getter<furi_get_fragment_from_uri>},
+    {"furi_split_authority", input::authority, b_split_authority},
+    {"furi_get_userinfo_from_authority", input::authority, b_getter<furi_get_userinfo_from_authority>},
+    {"furi_get_host_from_authority", input::authority, b_getter<furi_get_host_from_authority>},
+    {"furi_get_port_from_authority", input::authority, b_getter<furi_get_port_from_authority>},
+    {"furi_path_iter", input::path, b_path_iter},
+    {"furi_query_iter", input::query, b_query_iter},
+    {"query_lookup_iter", input::query, b_query_lookup_iter},
+    {"furi_query_index", input::query, b_query_lookup_index},
+    {"furi_query_extract", input::query, b_query_extract},
+    {"furi_router", input::path, b_router},
+    {"router_linear", input::path, b_router_linear},
+    {"furi_uri_store", input::uri, b_uri_store},
+    {"furi_build_uri", input::uri, b_build_uri},
+    {"build_uri_append", input::uri, b_build_uri_append},
+    {"furi_query_edit", input::query, b_query_edit},
+    {"query_edit_join", input::query, b_query_edit_join},
+    {"furi_suffix_trie", input::authority, b_suffix_trie},
+    {"suffix_hash_set", input::authority, b_suffix_hash_set},
+    {"furi_classify_scheme", input::uri, b_classify_scheme},
+    {"scheme_compare", input::uri, b_scheme_compare},
+    {"furi_sv_iequals", input::uri, b_sv_iequals},
+    {"sv_iequals_tolower", input::uri, b_sv_iequals_tolower},
+    {"furi_cache_key_hash", input::uri, b_cache_key_hash},
+    {"cache_key_join", input::uri, b_cache_key_join},
+};
+
+struct inputs
+{
+    std::vector<furi_sv> uri, authority, path, query;
+
+    const std::vector<furi_sv>& get(input in) const
+    {
+        switch (in)
+        {
+        case input::authority: return authority;
+        case input::path: return path;
+        case input::query: return query;
+        default: return uri;
+        }
+    }
+};
+
+inputs make_inputs(const bench::corpus& c)
+{
+    inputs ret;
+    for (auto& str : c.uris)
+    {
+        auto u = furi_make_sv(str.data(), str.data() + str.size());
+        auto s = furi_split_uri(u);
+        ret.uri.push_back(u);
+        ret.authority.push_back(s.authority);
+        ret.path.push_back(s.path);
+        ret.query.push_back(s.query);
+    }
+    return ret;
+}
+
+uint64_t tsc()
+{
+#if defined(FURI_BENCH_HAS_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct result
+{
+    double ns_per_uri;
+    double bytes_per_cycle;
+};
+
+volatile uint64_t g_sink;
+
+result run(bench_func f, const std::vector<furi_sv>& in, size_t bytes, double min_time_ms)
+{
+    using clock = std::chrono::steady_clock;
+
+    g_sink = f(in.data(), in.size()); // warmup
+
+    double best_ns = 1e300;
+    uint64_t best_cycles = 0;
+    double total_ms = 0;
+    for (int runs = 0; runs < 5 || total_ms < min_time_ms; ++runs)
+    {
+        auto start = clock::now();
+        auto c0 = tsc();
+        g_sink = f(in.data(), in.size());
+        auto c1 = tsc();
+        double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+        total_ms += ns / 1e6;
+        if (ns < best_ns)
+        {
+            best_ns = ns;
+            best_cycles = c1 - c0;
+        }
+    }
+
+    result ret;
+    ret.ns_per_uri = best_ns / double(in.size());
+    ret.bytes_per_cycle = best_cycles ? double(bytes) / double(best_cycles) : -1;
+    return ret;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const char* out_path = nullptr;
+    const char* filter = nullptr;
+    double min_time_ms = 200;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        auto arg_is = [&](const char* name) { return std::strcmp(argv[i], name) == 0 && i + 1 < argc; };
+        if (arg_is("--out")) out_path = argv[++i];
+        else if (arg_is("--min-time")) min_time_ms = std::atof(argv[++i]);
+        else if (arg_is("--filter")) filter = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--out file.json] [--min-time ms] [--filter substring]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE* out = stdout;
+    if (out_path)
+    {
+        out = std::fopen(out_path, "w");
+        if (!out)
+        {
+            std::fprintf(stderr, "cannot open %s\n", out_path);
+            return 1;
+        }
+    }
+
+    auto corpora = bench::make_corpora();
+
+    std::fprintf(out, "{\n  \"engine\": \"%s\",\n  \"results\": [", furi_simd_engine_name());
+
+    const char* sep = "\n";
+    for (auto& c : corpora)
+    {
+        auto in = make_inputs(c);
+        for (auto& b : benchmarks)
+        {
+            if (filter && !std::strstr(b.name, filter) && c.name.find(filter) == std::string::npos) continue;
+
+            auto& data = in.get(b.in);
+            size_t bytes = 0;
+            for (auto& sv : data) bytes += furi_sv_length(sv);
+
+            auto r = run(b.func, data, bytes, min_time_ms);
+
+            std::fprintf(out, "%s    {\"corpus\": \"%s\", \"benchmark\": \"%s\", \"uris\": %zu, \"bytes\": %zu, \"ns_per_uri\": %.3f, ",
+                sep, c.name.c_str(), b.name, data.size(), bytes, r.ns_per_uri);
+            if (r.bytes_per_cycle < 0) std::fprintf(out, "\"bytes_per_cycle\": null}");
+            else std::fprintf(out, "\"bytes_per_cycle\": %.3f}", r.bytes_per_cycle);
+            sep = ",\n";
+            std::fflush(out);
+        }
+    }
+
+    std::fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,213 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// synthetic corpora which model real traffic
+// they are generated from a fixed seed, so results are comparable between runs and releases
+
+namespace bench
+{
+
+class rng
+{
+    uint64_t m_state;
+public:
+    explicit rng(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next()
+    {
+        // xorshift64*
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1DULL;
+    }
+
+    size_t range(size_t min, size_t max) { return min + size_t(next() % (max - min + 1)); }
+
+    template <size_t N>
+    const char* pick(const char* const (&arr)[N]) { return arr[next() % N]; }
+
+    void append_token(std::string& out, size_t len)
+    {
+        static const char chars[] = "abcdefghijklmnopqrstuvwxyz0123456789-_";
+        for (size_t i = 0; i < len; ++i) out += chars[next() % (sizeof(chars) - 1)];
+    }
+
+    void append_hex(std::string& out, size_t len)
+    {
+        static const char chars[] = "0123456789abcdef";
+        for (size_t i = 0; i < len; ++i) out += chars[next() % 16];
+    }
+};
+
+struct corpus
+{
+    std::string name;
+    std::vector<std::string> uris;
+};
+
+static const char* const path_words[] = {
+    "api", "v1", "v2", "users", "items", "search", "static", "img", "css", "js", "products", "cart", "checkout",
+    "account", "settings", "index.html", "assets", "feed", "comments", "posts",
+};
+
+static const char* const hosts[] = {
+    "example.com", "www.example.org", "cdn.static.example.net", "api.service.internal", "shop.example.co.uk",
+};
+
+inline void append_path(rng& r, std::string& out, size_t min_segments, size_t max_segments)
+{
+    size_t n = r.range(min_segments, max_segments);
+    for (size_t i = 0; i < n; ++i)
+    {
+        out += '/';
+        if (r.next() % 4 == 0) r.append_token(out, r.range(3, 12));
+        else out += r.pick(path_words);
+    }
+}
+
+// short origin-form request targets: /path?query
+inline corpus make_origin_form(size_t count)
+{
+    corpus ret{"origin-form", {}};
+    rng r(1);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string u;
+        append_path(r, u, 1, 4);
+        if (r.next() % 2)
+        {
+            u += "?id=";
+            r.append_token(u, r.range(2, 8));
+            if (r.next() % 2)
+            {
+                u += "&page=";
+                u += std::to_string(r.range(1, 100));
+            }
+        }
+        ret.uris.push_back(std::move(u));
+    }
+    return ret;
+}
+
+// long absolute uris with tracking query parameters (2-8 KB)
+inline corpus make_tracking(size_t count)
+{
+    static const char* const keys[] = {
+        "utm_source", "utm_medium", "utm_campaign", "utm_term", "utm_content", "gclid", "fbclid", "msclkid",
+        "ref", "session", "ts", "click_id", "redirect", "payload",
+    };
+    corpus ret{"tracking", {}};
+    rng r(2);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string u = "https://";
+        u += r.pick(hosts);
+        append_path(r, u, 1, 5);
+        size_t target = r.range(2048, 8192);
+        char sep = '?';
+        while (u.size() < target)
+        {
+            u += sep;
+            sep = '&';
+            u += r.pick(keys);
+            u += '=';
+            if (r.next() % 3 == 0) r.append_hex(u, r.range(32, 256));
+            else r.append_token(u, r.range(4, 40));
+        }
+        if (r.next() % 4 == 0)
+        {
+            u += '#';
+            r.append_token(u, r.range(3, 10));
+        }
+        ret.uris.push_back(std::move(u));
+    }
+    return ret;
+}
+
+// absolute uris with ipv6 hosts
+inline corpus make_ipv6(size_t count)
+{
+    corpus ret{"ipv6", {}};
+    rng r(3);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string u = r.next() % 2 ? "http://[" : "https://[";
+        if (r.next() % 3 == 0)
+        {
+            u += "::";
+            r.append_hex(u, r.range(1, 4));
+        }
+        else
+        {
+            u += "2001:db8";
+            size_t groups = r.range(2, 6);
+            for (size_t g = 0; g < groups; ++g)
+            {
+                u += g == 1 && groups < 6 ? "::" : ":";
+                r.append_hex(u, r.range(1, 4));
+            }
+        }
+        u += ']';
+        if (r.next() % 2)
+        {
+            u += ':';
+            u += std::to_string(r.range(1, 65535));
+        }
+        append_path(r, u, 0, 3);
+        if (r.next() % 2)
+        {
+            u += "?q=";
+            r.append_token(u, r.range(2, 10));
+        }
+        ret.uris.push_back(std::move(u));
+    }
+    return ret;
+}
+
+// uris with userinfo in the authority
+inline corpus make_userinfo(size_t count)
+{
+    static const char* const schemes[] = {"ftp", "sftp", "http", "https", "ssh", "redis", "postgres"};
+    corpus ret{"userinfo", {}};
+    rng r(4);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string u = r.pick(schemes);
+        u += "://";
+        r.append_token(u, r.range(3, 16));
+        if (r.next() % 4 != 0)
+        {
+            u += ':';
+            r.append_token(u, r.range(6, 24));
+            if (r.next() % 2) u += "%40x";
+        }
+        u += '@';
+        u += r.pick(hosts);
+        if (r.next() % 2)
+        {
+            u += ':';
+            u += std::to_string(r.range(1, 65535));
+        }
+        append_path(r, u, 0, 4);
+        ret.uris.push_back(std::move(u));
+    }
+    return ret;
+}
+
+inline std::vector<corpus> make_corpora()
+{
+    std::vector<corpus> ret;
+    ret.push_back(make_origin_form(10000));
+    ret.push_back(make_tracking(500));
+    ret.push_back(make_ipv6(10000));
+    ret.push_back(make_userinfo(10000));
+    return ret;
+}
+
+}
@@ -0,0 +1,421 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// percent encoding
+// chars of the class cc are written as they are and the rest (including '%') as %XX escapes
+// with uppercase hex digits
+
+FURI_INLINE size_t furi_pct_encoded_length(furi_sv in, furi_char_class cc)
+{
+    size_t ret = furi_sv_length(in);
+    const char* p = in.begin;
+    while (p != in.end)
+    {
+        p = furi_find_invalid_char(p, in.end, cc, false);
+        if (!p) break;
+        ret += 2;
+        ++p;
+    }
+    return ret;
+}
+
+// out must have room for furi_pct_encoded_length(in, cc) chars
+// returns the end of the output
+FURI_INLINE char* furi_pct_encode(furi_sv in, char* out, furi_char_class cc)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    const char* p = in.begin;
+    while (p != in.end)
+    {
+        // copy runs with nothing to encode in bulk
+        const char* f = furi_find_invalid_char(p, in.end, cc, false);
+        size_t run = (f ? f : in.end) - p;
+        if (run) memcpy(out, p, run);
+        out += run;
+        if (!f) break;
+
+        unsigned char c = (unsigned char)*f;
+        *out++ = '%';
+        *out++ = hex[c >> 4];
+        *out++ = hex[c & 0xF];
+        p = f + 1;
+    }
+    return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// uri building
+// the inverse of furi_split_uri: writes a uri from its components
+// the exact length is computed first, so the output can be allocated once
+//
+// null components are omitted and empty ones are written with their delimiters
+// ("?" for an empty query and so on)
+// the authority is written if any of authority, userinfo, host, or port is not null
+// if authority is not null, it's written as it is and userinfo, host, and port are ignored
+// query items are appended to the query as "key=value" (or "key" if the value is null) separated by '&'
+// if there is an authority, a '/' is inserted before a path which doesn't begin with one
+// paths which would be ambiguous without an authority ("//a" or "a:b" with no scheme) are written as they are
+//
+// with encode set, the components are taken to be decoded text and are percent encoded:
+//  * userinfo, reg-name hosts, path, query, and fragment with their RFC 3986 character sets
+//  * query item keys and values with the unreserved set (like application/x-www-form-urlencoded
+//    but with spaces as %20)
+// scheme, authority, ip literal hosts ("[...]"), and port are always written as they are
+
+typedef struct furi_uri_parts
+{
+    furi_sv scheme;
+    furi_sv authority;
+    furi_sv userinfo;
+    furi_sv host;
+    furi_sv port;
+    furi_sv path;
+    furi_sv query;
+    const furi_query_iter_value* query_items;
+    size_t num_query_items;
+    furi_sv fragment;
+} furi_uri_parts;
+
+// length of a component which is encoded with cc if encode is set
+FURI_INLINE size_t furi_build_component_length(furi_sv sv, furi_char_class cc, bool encode)
+{
+    return encode ? furi_pct_encoded_length(sv, cc) : furi_sv_length(sv);
+}
+
+FURI_INLINE char* furi_build_write(char* o, furi_sv sv, furi_char_class cc, bool encode)
+{
+    if (encode) return furi_pct_encode(sv, o, cc);
+    size_t len = furi_sv_length(sv);
+    if (len) memcpy(o, sv.begin, len);
+    return o + len;
+}
+
+FURI_INLINE bool furi_build_has_authority(const furi_uri_parts* p)
+{
+    return p->authority.begin || p->userinfo.begin || p->host.begin || p->port.begin;
+}
+
+FURI_INLINE bool furi_build_host_is_ip_literal(furi_sv host)
+{
+    return !furi_sv_is_empty(host) && host.begin[0] == '[';
+}
+
+FURI_INLINE bool furi_build_needs_root(const furi_uri_parts* p)
+{
+    return furi_build_has_authority(p) && !furi_sv_is_empty(p->path) && p->path.begin[0] != '/';
+}
+
+// the exact length of the uri furi_build_uri writes
+FURI_INLINE size_t furi_build_uri_length(const furi_uri_parts* p, bool encode)
+{
+    size_t ret = 0;
+    if (p->scheme.begin) ret += furi_sv_length(p->scheme) + 1;
+
+    if (p->authority.begin)
+    {
+        ret += 2 + furi_sv_length(p->authority);
+    }
+    else if (furi_build_has_authority(p))
+    {
+        ret += 2;
+        if (p->userinfo.begin) ret += furi_build_component_length(p->userinfo, FURI_CC_USERINFO, encode) + 1;
+        ret += furi_build_component_length(p->host, FURI_CC_REG_NAME, encode && !furi_build_host_is_ip_literal(p->host));
+        if (p->port.begin) ret += furi_sv_length(p->port) + 1;
+    }
+
+    ret += furi_build_needs_root(p) + furi_build_component_length(p->path, FURI_CC_PATH, encode);
+
+    if (p->query.begin || p->num_query_items)
+    {
+        ret += 1 + furi_build_component_length(p->query, FURI_CC_QUERY, encode);
+        for (size_t i = 0; i < p->num_query_items; ++i)
+        {
+            const furi_query_iter_value* item = p->query_items + i;
+            if (i || !furi_sv_is_empty(p->query)) ++ret; // '&'
+            ret += furi_build_component_length(item->key, FURI_CC_UNRESERVED, encode);
+            if (item->value.begin) ret += 1 + furi_build_component_length(item->value, FURI_CC_UNRESERVED, encode);
+        }
+    }
+
+    if (p->fragment.begin) ret += 1 + furi_build_component_length(p->fragment, FURI_CC_QUERY, encode);
+    return ret;
+}
+
+// out must have room for furi_build_uri_length(p, encode) chars
+// returns the reference split of the written uri which is [out, req_path.end)
+// (path is never null and req_path is [path.begin, end) as with furi_split_reference)
+FURI_INLINE furi_uri_split furi_build_uri(const furi_uri_parts* p, char* out, bool encode)
+{
+    furi_uri_split ret = FURI_EMPTY_VAL;
+    char* o = out;
+
+    if (p->scheme.begin)
+    {
+        o = furi_build_write(o, p->scheme, FURI_CC_SCHEME, false);
+        ret.scheme = furi_make_sv(out, o);
+        *o++ = ':';
+    }
+
+    if (furi_build_has_authority(p))
+    {
+        *o++ = '/';
+        *o++ = '/';
+        char* abegin = o;
+        if (p->authority.begin)
+        {
+            o = furi_build_write(o, p->authority, FURI_CC_REG_NAME, false);
+        }
+        else
+        {
+            if (p->userinfo.begin)
+            {
+                o = furi_build_write(o, p->userinfo, FURI_CC_USERINFO, encode);
+                *o++ = '@';
+            }
+            o = furi_build_write(o, p->host, FURI_CC_REG_NAME, encode && !furi_build_host_is_ip_literal(p->host));
+            if (p->port.begin)
+            {
+                *o++ = ':';
+                o = furi_build_write(o, p->port, FURI_CC_PORT, false);
+            }
+        }
+        ret.authority = furi_make_sv(abegin, o);
+    }
+
+    char* pbegin = o;
+    if (furi_build_needs_root(p)) *o++ = '/';
+    o = furi_build_write(o, p->path, FURI_CC_PATH, encode);
+    ret.path = furi_make_sv(pbegin, o);
+
+    if (p->query.begin || p->num_query_items)
+    {
+        *o++ = '?';
+        char* qbegin = o;
+        o = furi_build_write(o, p->query, FURI_CC_QUERY, encode);
+        for (size_t i = 0; i < p->num_query_items; ++i)
+        {
+            const furi_query_iter_value* item = p->query_items + i;
+            if (i || !furi_sv_is_empty(p->query)) *o++ = FURI_QUERY_ITEM_SEP;
+            o = furi_build_write(o, item->key, FURI_CC_UNRESERVED, encode);
+            if (item->value.begin)
+            {
+                *o++ = FURI_QUERY_KV_SEP;
+                o = furi_build_write(o, item->value, FURI_CC_UNRESERVED, encode);
+            }
+        }
+        ret.query = furi_make_sv(qbegin, o);
+    }
+
+    if (p->fragment.begin)
+    {
+        *o++ = '#';
+        char* fbegin = o;
+        o = furi_build_write(o, p->fragment, FURI_CC_QUERY, encode);
+        ret.fragment = furi_make_sv(fbegin, o);
+    }
+
+    ret.req_path = furi_make_sv(pbegin, o);
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// query editing
+// removes, replaces, and appends query items in a single pass over the query
+// items are the same as the ones of furi_query_iter and keys are compared as they are in the query
+// the remaining items keep their order and are copied as they are
+// the output is only written when something changes: until the first changed item nothing is copied,
+// and if there is none (and nothing to append), the query itself is returned
+// keys and values of set and append are written as they are (see furi_pct_encode)
+#define FURI_QUERY_EDIT_MAX_KEYS 64
+
+typedef bool (*furi_query_item_pred)(void* user_data, furi_query_iter_value item);
+
+typedef struct furi_query_edit
+{
+    // items with these keys are removed
+    const furi_sv* remove_keys;
+    uint32_t num_remove_keys;
+
+    // items for which this returns true are removed
+    furi_query_item_pred remove_if;
+    void* user_data;
+
+    // the first item with the key of set[i] gets its value (or no value if it's null)
+    // and the rest of the items with this key are removed
+    // if there is no such item, set[i] is appended
+    // items with these keys are not checked for removal
+    const furi_query_iter_value* set;
+    uint32_t num_set;
+
+    // appended after the sets in order
+    const furi_query_iter_value* append;
+    uint32_t num_append;
+} furi_query_edit;
+
+FURI_INLINE size_t furi_query_edit_items_length(const furi_query_iter_value* items, uint32_t count)
+{
+    size_t ret = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ret += furi_sv_length(items[i].key) + furi_sv_length(items[i].value) + 2;
+    }
+    return ret;
+}
+
+// out must have room for at least this many chars
+FURI_INLINE size_t furi_query_edit_max_length(furi_sv query, const furi_query_edit* e)
+{
+    return furi_sv_length(query)
+        + furi_query_edit_items_length(e->set, e->num_set)
+        + furi_query_edit_items_length(e->append, e->num_append);
+}
+
+// writes the item with a leading separator if it's not the first one
+FURI_INLINE char* furi_query_edit_write_item(char* o, bool* first, furi_sv key, furi_sv value)
+{
+    if (!*first) *o++ = FURI_QUERY_ITEM_SEP;
+    *first = false;
+    o = furi_build_write(o, key, FURI_CC_QUERY, false);
+    if (value.begin)
+    {
+        *o++ = FURI_QUERY_KV_SEP;
+        o = furi_build_write(o, value, FURI_CC_QUERY, false);
+    }
+    return o;
+}
+
+// index of the key in keys or -1
+FURI_INLINE int furi_query_edit_find_key(const furi_query_key_filter* filter, const furi_sv* keys, uint32_t count, furi_sv key)
+{
+    if (!furi_query_key_filter_match(filter, key)) return -1;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (furi_sv_cmp(keys[i], key) == 0) return (int)i;
+    }
+    return -1;
+}
+
+// index of the set with the key in e->set or -1
+FURI_INLINE int furi_query_edit_find_set(const furi_query_key_filter* filter, const furi_query_edit* e, furi_sv key)
+{
+    if (!furi_query_key_filter_match(filter, key)) return -1;
+    for (uint32_t i = 0; i < e->num_set; ++i)
+    {
+        if (furi_sv_cmp(e->set[i].key, key) == 0) return (int)i;
+    }
+    return -1;
+}
+
+// returns the edited query which is either query itself or written to out
+// out must have room for furi_query_edit_max_length chars
+FURI_INLINE furi_sv furi_query_edit_apply(furi_sv query, const furi_query_edit* e, char* out)
+{
+    assert(e->num_remove_keys <= FURI_QUERY_EDIT_MAX_KEYS);
+    assert(e->num_set <= FURI_QUERY_EDIT_MAX_KEYS);
+
+    furi_query_key_filter remove_filter = furi_make_query_key_filter(e->remove_keys, e->num_remove_keys);
+    furi_query_key_filter set_filter = FURI_EMPTY_VAL;
+    for (uint32_t i = 0; i < e->num_set; ++i) furi_query_key_filter_add(&set_filter, e->set[i].key);
+
+    uint64_t done = 0; // sets which were applied
+    bool copying = false;
+    bool first = true;
+    char* o = out;
+
+    const char* begin = query.begin;
+    while (!furi_sv_is_empty(query))
+    {
+        furi_query_iter_value item;
+        const char* p = furi_query_scan_item(begin, query.end, &item);
+        const char* item_end = p ? p : query.end;
+
+        // what happens to the item: kept, removed, or replaced by a set
+        bool keep = true;
+        const furi_query_iter_value* replacement = NULL;
+        int si = furi_query_edit_find_set(&set_filter, e, item.key);
+        if (si >= 0)
+        {
+            if (done & (1ull << si))
+            {
+                keep = false;
+            }
+            else
+            {
+                done |= 1ull << si;
+                const furi_query_iter_value* s = e->set + si;
+                bool same = s->value.begin ? item.value.begin && furi_sv_cmp(s->value, item.value) == 0 : !item.value.begin;
+                if (!same)
+                {
+                    keep = false;
+                    replacement = s;
+                }
+            }
+        }
+        else if (furi_query_edit_find_key(&remove_filter, e->remove_keys, e->num_remove_keys, item.key) >= 0
+            || (e->remove_if && e->remove_if(e->user_data, item)))
+        {
+            keep = false;
+        }
+
+        if (!keep && !copying)
+        {
+            // first change: copy the items before this one in bulk
+            copying = true;
+            if (begin != query.begin)
+            {
+                size_t len = begin - 1 - query.begin;
+                if (len) memcpy(o, query.begin, len);
+                o += len;
+                first = false;
+            }
+        }
+
+        if (copying)
+        {
+            if (keep) o = furi_query_edit_write_item(o, &first, furi_make_sv(begin, item_end), FURI_EMPTY_T(furi_sv));
+            else if (replacement) o = furi_query_edit_write_item(o, &first, replacement->key, replacement->value);
+        }
+
+        if (!p) break;
+        begin = p + 1;
+    }
+
+    uint64_t all = e->num_set == 64 ? ~0ull : (1ull << e->num_set) - 1;
+    if (!copying)
+    {
+        if (done == all && !e->num_append) return query;
+
+        size_t len = furi_sv_length(query);
+        if (len) memcpy(o, query.begin, len);
+        o += len;
+        first = !len;
+    }
+
+    for (uint64_t m = all & ~done; m; m &= m - 1)
+    {
+        const furi_query_iter_value* s = e->set + furi_ctz64(m);
+        o = furi_query_edit_write_item(o, &first, s->key, s->value);
+    }
+    for (uint32_t i = 0; i < e->num_append; ++i)
+    {
+        o = furi_query_edit_write_item(o, &first, e->append[i].key, e->append[i].value);
+    }
+
+    return furi_make_sv(out, o);
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,189 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "build.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace furi
+{
+
+// appends str to out, percent encoding the chars which are not in the class cc
+inline void pct_encode(opt_string_view str, capi::furi_char_class cc, std::string& out)
+{
+    auto offset = out.size();
+    out.resize(offset + capi::furi_pct_encoded_length(str.c_sv(), cc));
+    capi::furi_pct_encode(str.c_sv(), out.data() + offset, cc);
+}
+
+[[nodiscard]] inline std::string pct_encode(opt_string_view str, capi::furi_char_class cc)
+{
+    std::string ret;
+    pct_encode(str, cc, ret);
+    return ret;
+}
+
+// builds a uri from components (see capi::furi_build_uri)
+// the builder doesn't copy the components, so they must outlive it
+// the output is sized exactly before it's written, so a build allocates once at most
+class uri_builder
+{
+public:
+    uri_builder() = default;
+
+    // starts from the components of an existing uri
+    explicit uri_builder(const uri_split& s) noexcept
+    {
+        m_parts.scheme = s.scheme.c_sv();
+        m_parts.authority = s.authority.c_sv();
+        m_parts.path = s.path.c_sv();
+        m_parts.query = s.query.c_sv();
+        m_parts.fragment = s.fragment.c_sv();
+    }
+
+    uri_builder& scheme(opt_string_view s) noexcept { m_parts.scheme = s.c_sv(); return *this; }
+
+    // replaces userinfo, host, and port
+    uri_builder& authority(opt_string_view s) noexcept { m_parts.authority = s.c_sv(); return *this; }
+
+    // the parts of the authority are only used if no authority is set
+    uri_builder& userinfo(opt_string_view s) noexcept { m_parts.userinfo = s.c_sv(); return *this; }
+    uri_builder& host(opt_string_view s) noexcept { m_parts.host = s.c_sv(); return *this; }
+    uri_builder& port(opt_string_view s) noexcept { m_parts.port = s.c_sv(); return *this; }
+
+    uri_builder& path(opt_string_view s) noexcept { m_parts.path = s.c_sv(); return *this; }
+    uri_builder& query(opt_string_view s) noexcept { m_parts.query = s.c_sv(); return *this; }
+    uri_builder& fragment(opt_string_view s) noexcept { m_parts.fragment = s.c_sv(); return *this; }
+
+    // appended to the query in order
+    uri_builder& add_query_item(opt_string_view key, opt_string_view value = {})
+    {
+        m_items.push_back({key.c_sv(), value.c_sv()});
+        return *this;
+    }
+
+    // percent encode the components as they are written (see capi::furi_build_uri)
+    uri_builder& encode(bool e = true) noexcept { m_encode = e; return *this; }
+
+    [[nodiscard]] size_t length() const noexcept
+    {
+        auto p = parts();
+        return capi::furi_build_uri_length(&p, m_encode);
+    }
+
+    // appends the uri to out and returns its split which points into out
+    uri_split build(std::string& out) const
+    {
+        auto p = parts();
+        auto offset = out.size();
+        out.resize(offset + capi::furi_build_uri_length(&p, m_encode));
+        return uri_split::from_capi(capi::furi_build_uri(&p, out.data() + offset, m_encode));
+    }
+
+    [[nodiscard]] std::string build() const
+    {
+        std::string ret;
+        build(ret);
+        return ret;
+    }
+
+private:
+    capi::furi_uri_parts parts() const noexcept
+    {
+        auto ret = m_parts;
+        ret.query_items = m_items.data();
+        ret.num_query_items = m_items.size();
+        return ret;
+    }
+
+    capi::furi_uri_parts m_parts = {};
+    std::vector<capi::furi_query_iter_value> m_items;
+    bool m_encode = false;
+};
+
+// edits queries (see capi::furi_query_edit_apply)
+// an editor is set up once and applied to many queries
+// it doesn't copy keys or values, so they must outlive it (the predicate is stored in the editor)
+class query_editor
+{
+public:
+    using predicate = std::function<bool(opt_string_view key, opt_string_view value)>;
+
+    query_editor() = default;
+
+    // removes the items with key
+    query_editor& remove(opt_string_view key)
+    {
+        assert(m_remove.size() < FURI_QUERY_EDIT_MAX_KEYS);
+        m_remove.push_back(key.c_sv());
+        return *this;
+    }
+
+    // removes the items for which pred(key, value) returns true
+    query_editor& remove_if(predicate pred)
+    {
+        m_pred = std::move(pred);
+        return *this;
+    }
+
+    // replaces the value of the first item with key and removes the rest (or appends the item if there is none)
+    query_editor& set(opt_string_view key, opt_string_view value)
+    {
+        assert(m_set.size() < FURI_QUERY_EDIT_MAX_KEYS);
+        m_set.push_back({key.c_sv(), value.c_sv()});
+        return *this;
+    }
+
+    query_editor& append(opt_string_view key, opt_string_view value = {})
+    {
+        m_append.push_back({key.c_sv(), value.c_sv()});
+        return *this;
+    }
+
+    // returns query itself if nothing changes, otherwise the edited query which is written to buf
+    // buf is only resized if it's too small for the edited query
+    opt_string_view apply(opt_string_view query, std::string& buf) const
+    {
+        auto e = edit();
+        auto max = capi::furi_query_edit_max_length(query.c_sv(), &e);
+        if (buf.size() < max) buf.resize(max);
+        return opt_string_view(capi::furi_query_edit_apply(query.c_sv(), &e, buf.data()));
+    }
+
+    [[nodiscard]] std::string apply(opt_string_view query) const
+    {
+        std::string buf;
+        return std::string(apply(query, buf));
+    }
+
+private:
+    capi::furi_query_edit edit() const noexcept
+    {
+        capi::furi_query_edit ret = {};
+        ret.remove_keys = m_remove.data();
+        ret.num_remove_keys = uint32_t(m_remove.size());
+        if (m_pred)
+        {
+            ret.remove_if = [](void* user_data, capi::furi_query_iter_value item) -> bool {
+                auto& pred = *static_cast<const predicate*>(user_data);
+                return pred(opt_string_view(item.key), opt_string_view(item.value));
+            };
+            ret.user_data = const_cast<predicate*>(&m_pred);
+        }
+        ret.set = m_set.data();
+        ret.num_set = uint32_t(m_set.size());
+        ret.append = m_append.data();
+        ret.num_append = uint32_t(m_append.size());
+        return ret;
+    }
+
+    std::vector<capi::furi_sv> m_remove;
+    predicate m_pred;
+    std::vector<capi::furi_query_iter_value> m_set;
+    std::vector<capi::furi_query_iter_value> m_append;
+};
+
+}
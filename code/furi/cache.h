@@ -0,0 +1,333 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+#include <stdlib.h> // qsort
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// streaming hash
+// a 128-bit hash of a byte string fed in slices
+// the result depends only on the bytes and not on how they are sliced
+// it's meant for hash tables and cache keys and is not cryptographic
+// words are read as little-endian, so the values are the same on all platforms
+
+typedef struct furi_hash128
+{
+    uint64_t lo;
+    uint64_t hi;
+} furi_hash128;
+
+typedef struct furi_hash_state
+{
+    uint64_t h1;
+    uint64_t h2;
+    uint64_t tail; // the bytes which don't make a word yet
+    uint32_t tail_length;
+    uint64_t length;
+} furi_hash_state;
+
+#define FURI_HASH_C1 0x87c37b91114253d5ull
+#define FURI_HASH_C2 0x4cf5ad432745937full
+
+FURI_INLINE uint64_t furi_rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+FURI_INLINE uint64_t furi_hash_fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+FURI_INLINE furi_hash_state furi_make_hash_state(uint64_t seed)
+{
+    furi_hash_state ret = FURI_EMPTY_VAL;
+    ret.h1 = seed;
+    ret.h2 = seed ^ FURI_HASH_C1;
+    return ret;
+}
+
+FURI_INLINE void furi_hash_word(furi_hash_state* st, uint64_t w)
+{
+    st->h1 ^= furi_rotl64(w * FURI_HASH_C1, 31) * FURI_HASH_C2;
+    st->h1 = furi_rotl64(st->h1, 27) * 5 + 0x52dce729;
+    st->h2 ^= furi_rotl64(w * FURI_HASH_C2, 33) * FURI_HASH_C1;
+    st->h2 = furi_rotl64(st->h2, 31) * 5 + 0x38495ab5;
+}
+
+FURI_INLINE uint64_t furi_hash_load64(const char* p)
+{
+    uint64_t w;
+    memcpy(&w, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+FURI_INLINE void furi_hash_feed(furi_hash_state* st, furi_sv sv)
+{
+    const char* p = sv.begin;
+    size_t len = furi_sv_length(sv);
+    st->length += len;
+
+    // complete the tail
+    while (st->tail_length && len)
+    {
+        st->tail |= (uint64_t)(unsigned char)*p++ << (8 * st->tail_length);
+        --len;
+        if (++st->tail_length == 8)
+        {
+            furi_hash_word(st, st->tail);
+            st->tail = 0;
+            st->tail_length = 0;
+        }
+    }
+
+    for (; len >= 8; p += 8, len -= 8)
+    {
+        furi_hash_word(st, furi_hash_load64(p));
+    }
+
+    for (; len; --len)
+    {
+        st->tail |= (uint64_t)(unsigned char)*p++ << (8 * st->tail_length++);
+    }
+}
+
+FURI_INLINE void furi_hash_feed_char(furi_hash_state* st, char c)
+{
+    furi_hash_feed(st, furi_make_sv(&c, &c + 1));
+}
+
+FURI_INLINE furi_hash128 furi_hash_finish(const furi_hash_state* st)
+{
+    furi_hash_state s = *st;
+    if (s.tail_length) furi_hash_word(&s, s.tail);
+    s.h1 ^= s.length;
+    s.h2 ^= s.length;
+    s.h1 += s.h2;
+    s.h2 += s.h1;
+    s.h1 = furi_hash_fmix64(s.h1);
+    s.h2 = furi_hash_fmix64(s.h2);
+    s.h1 += s.h2;
+    s.h2 += s.h1;
+
+    furi_hash128 ret = {s.h1, s.h2};
+    return ret;
+}
+
+FURI_INLINE furi_hash128 furi_hash(furi_sv sv, uint64_t seed)
+{
+    furi_hash_state st = furi_make_hash_state(seed);
+    furi_hash_feed(&st, sv);
+    return furi_hash_finish(&st);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// cache keys
+// a canonical form of a uri, so that uris which only differ in the order of query items or in
+// components and query items which don't matter map to the same key
+// the key is the uri (split with furi_split_uri) with:
+//  * only the components selected in the config (the delimiters of the others are dropped too)
+//  * only the query items which pass the key filter, with the empty ones dropped
+//  * optionally the query items sorted by key and then value (with no value before an empty one)
+//  * no '?' if no query items remain
+// keys are compared as they are in the query (not percent decoded)
+// to also merge uris which differ in case or percent escapes, normalize them first (see furi/normalize)
+//
+// the key can be written or only hashed: the hash is the same as furi_hash of the written key,
+// but it's computed from the slices of the uri without copying them
+// sorting needs scratch space for the query items: keys of queries with more items fail
+
+#define FURI_CACHE_KEY_MAX_QUERY_KEYS 64
+
+typedef enum furi_cache_key_filter
+{
+    FURI_CACHE_KEY_ALL_ITEMS, // keys is ignored
+    FURI_CACHE_KEY_ALLOW, // only items with keys in keys
+    FURI_CACHE_KEY_DENY // only items with keys not in keys
+} furi_cache_key_filter;
+
+typedef struct furi_cache_key_config
+{
+    int components; // furi_uri_component flags: scheme, authority, path, query, fragment (req_path is ignored)
+    furi_cache_key_filter filter;
+    const furi_sv* keys;
+    uint32_t num_keys;
+    bool sort_query;
+} furi_cache_key_config;
+
+// where the key goes: out if it's not null, otherwise hash
+typedef struct furi_cache_key_sink
+{
+    char* out;
+    furi_hash_state* hash;
+} furi_cache_key_sink;
+
+FURI_INLINE void furi_cache_key_emit(furi_cache_key_sink* sink, furi_sv sv)
+{
+    if (!sink->out)
+    {
+        furi_hash_feed(sink->hash, sv);
+        return;
+    }
+    size_t len = furi_sv_length(sv);
+    if (len) memcpy(sink->out, sv.begin, len);
+    sink->out += len;
+}
+
+FURI_INLINE void furi_cache_key_emit_char(furi_cache_key_sink* sink, char c)
+{
+    if (sink->out) *sink->out++ = c;
+    else furi_hash_feed_char(sink->hash, c);
+}
+
+// emits the item (with a leading delimiter which is '?' for the first one)
+FURI_INLINE void furi_cache_key_emit_item(furi_cache_key_sink* sink, const furi_query_iter_value* item, bool* first)
+{
+    furi_cache_key_emit_char(sink, *first ? '?' : FURI_QUERY_ITEM_SEP);
+    *first = false;
+    furi_cache_key_emit(sink, item->key);
+    if (item->value.begin)
+    {
+        furi_cache_key_emit_char(sink, FURI_QUERY_KV_SEP);
+        furi_cache_key_emit(sink, item->value);
+    }
+}
+
+FURI_INLINE int furi_cache_key_item_cmp(const void* a, const void* b)
+{
+    const furi_query_iter_value* ia = (const furi_query_iter_value*)a;
+    const furi_query_iter_value* ib = (const furi_query_iter_value*)b;
+    int c = furi_sv_cmp(ia->key, ib->key);
+    if (c) return c;
+    if (!ia->value.begin || !ib->value.begin) return !!ia->value.begin - !!ib->value.begin;
+    return furi_sv_cmp(ia->value, ib->value);
+}
+
+FURI_INLINE void furi_cache_key_sort_items(furi_query_iter_value* items, uint32_t n)
+{
+    // insertion sort for the typical short queries
+    if (n > 16)
+    {
+        qsort(items, n, sizeof(furi_query_iter_value), furi_cache_key_item_cmp);
+        return;
+    }
+    for (uint32_t i = 1; i < n; ++i)
+    {
+        furi_query_iter_value item = items[i];
+        uint32_t j = i;
+        for (; j && furi_cache_key_item_cmp(items + j - 1, &item) > 0; --j) items[j] = items[j - 1];
+        items[j] = item;
+    }
+}
+
+// returns false if the query has more items than scratch_capacity (only when sorting)
+FURI_INLINE bool furi_cache_key_emit_uri(const furi_cache_key_config* c, furi_sv uri,
+    furi_query_iter_value* scratch, uint32_t scratch_capacity, furi_cache_key_sink* sink)
+{
+    assert(c->filter == FURI_CACHE_KEY_ALL_ITEMS || c->num_keys <= FURI_CACHE_KEY_MAX_QUERY_KEYS);
+    furi_uri_split s = furi_split_uri_masked(uri, c->components);
+
+    if (s.scheme.begin)
+    {
+        furi_cache_key_emit(sink, s.scheme);
+        furi_cache_key_emit_char(sink, ':');
+    }
+    if (s.authority.begin)
+    {
+        furi_cache_key_emit(sink, furi_make_sv_from_string("//"));
+        furi_cache_key_emit(sink, s.authority);
+    }
+    furi_cache_key_emit(sink, s.path);
+
+    if (!furi_sv_is_empty(s.query))
+    {
+        furi_query_key_filter filter = FURI_EMPTY_VAL;
+        if (c->filter != FURI_CACHE_KEY_ALL_ITEMS) filter = furi_make_query_key_filter(c->keys, c->num_keys);
+
+        uint32_t n = 0;
+        bool first = true;
+        const char* begin = s.query.begin;
+        for (;;)
+        {
+            furi_query_iter_value item;
+            const char* p = furi_query_scan_item(begin, s.query.end, &item);
+
+            bool pass = !furi_sv_is_empty(item.key) || item.value.begin;
+            if (pass && c->filter != FURI_CACHE_KEY_ALL_ITEMS)
+            {
+                bool listed = false;
+                if (furi_query_key_filter_match(&filter, item.key))
+                {
+                    for (uint32_t i = 0; i < c->num_keys && !listed; ++i) listed = furi_sv_cmp(c->keys[i], item.key) == 0;
+                }
+                pass = listed == (c->filter == FURI_CACHE_KEY_ALLOW);
+            }
+
+            if (pass)
+            {
+                if (!c->sort_query) furi_cache_key_emit_item(sink, &item, &first);
+                else if (n == scratch_capacity) return false;
+                else scratch[n++] = item;
+            }
+
+            if (!p) break;
+            begin = p + 1;
+        }
+
+        if (c->sort_query)
+        {
+            furi_cache_key_sort_items(scratch, n);
+            for (uint32_t i = 0; i < n; ++i) furi_cache_key_emit_item(sink, scratch + i, &first);
+        }
+    }
+
+    if (s.fragment.begin)
+    {
+        furi_cache_key_emit_char(sink, '#');
+        furi_cache_key_emit(sink, s.fragment);
+    }
+    return true;
+}
+
+// out must have room for furi_sv_length(uri) chars (a key is never longer than its uri)
+// returns the end of the key or NULL if sorting needs more scratch space
+FURI_INLINE char* furi_cache_key_write(const furi_cache_key_config* c, furi_sv uri,
+    furi_query_iter_value* scratch, uint32_t scratch_capacity, char* out)
+{
+    furi_cache_key_sink sink = {out, NULL};
+    if (!furi_cache_key_emit_uri(c, uri, scratch, scratch_capacity, &sink)) return NULL;
+    return sink.out;
+}
+
+// the same as furi_hash of the key furi_cache_key_write would write
+// returns false if sorting needs more scratch space
+FURI_INLINE bool furi_cache_key_hash(const furi_cache_key_config* c, furi_sv uri,
+    furi_query_iter_value* scratch, uint32_t scratch_capacity, uint64_t seed, furi_hash128* out)
+{
+    furi_hash_state st = furi_make_hash_state(seed);
+    furi_cache_key_sink sink = {NULL, &st};
+    if (!furi_cache_key_emit_uri(c, uri, scratch, scratch_capacity, &sink)) return false;
+    *out = furi_hash_finish(&st);
+    return true;
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,120 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "cache.h"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace furi
+{
+
+using hash128 = capi::furi_hash128;
+
+inline bool operator==(const hash128& a, const hash128& b) noexcept { return a.lo == b.lo && a.hi == b.hi; }
+inline bool operator!=(const hash128& a, const hash128& b) noexcept { return !(a == b); }
+
+// see capi::furi_hash
+inline hash128 hash_str(opt_string_view str, uint64_t seed = 0) noexcept
+{
+    return capi::furi_hash(str.c_sv(), seed);
+}
+
+// canonical cache keys of uris (see capi::furi_cache_key_write)
+// a generator is set up once and used for many uris
+// it doesn't copy the query keys, so they must outlive it
+// queries with up to inline_items items are sorted without allocating
+class cache_key_generator
+{
+public:
+    static constexpr uint32_t inline_items = 64;
+
+    explicit cache_key_generator(int components = capi::FURI_URI_SCHEME | capi::FURI_URI_AUTHORITY
+        | capi::FURI_URI_PATH | capi::FURI_URI_QUERY) noexcept
+    {
+        m_config.components = components;
+        m_config.filter = capi::FURI_CACHE_KEY_ALL_ITEMS;
+    }
+
+    // only items with the allowed keys are in the key
+    cache_key_generator& allow(opt_string_view key) { return add_key(capi::FURI_CACHE_KEY_ALLOW, key); }
+
+    // items with the denied keys are not in the key
+    // a generator either allows or denies keys
+    cache_key_generator& deny(opt_string_view key) { return add_key(capi::FURI_CACHE_KEY_DENY, key); }
+
+    cache_key_generator& sort_query(bool sort = true) noexcept
+    {
+        m_config.sort_query = sort;
+        return *this;
+    }
+
+    // appends the key to out
+    void key(opt_string_view uri, std::string& out) const
+    {
+        auto offset = out.size();
+        out.resize(offset + uri.size());
+        auto c = config();
+        char* end = with_scratch(uri, [&](capi::furi_query_iter_value* scratch, uint32_t capacity) {
+            return capi::furi_cache_key_write(&c, uri.c_sv(), scratch, capacity, out.data() + offset);
+        });
+        out.resize(size_t(end - out.data()));
+    }
+
+    [[nodiscard]] std::string key(opt_string_view uri) const
+    {
+        std::string ret;
+        key(uri, ret);
+        return ret;
+    }
+
+    // the same as hash_str(key(uri), seed) without writing the key
+    [[nodiscard]] hash128 hash(opt_string_view uri, uint64_t seed = 0) const
+    {
+        hash128 ret = {};
+        auto c = config();
+        with_scratch(uri, [&](capi::furi_query_iter_value* scratch, uint32_t capacity) {
+            return capi::furi_cache_key_hash(&c, uri.c_sv(), scratch, capacity, seed, &ret);
+        });
+        return ret;
+    }
+
+    [[nodiscard]] uint64_t hash64(opt_string_view uri, uint64_t seed = 0) const { return hash(uri, seed).lo; }
+
+    [[nodiscard]] capi::furi_cache_key_config config() const noexcept
+    {
+        auto ret = m_config;
+        ret.keys = m_keys.data();
+        ret.num_keys = uint32_t(m_keys.size());
+        return ret;
+    }
+
+private:
+    cache_key_generator& add_key(capi::furi_cache_key_filter filter, opt_string_view key)
+    {
+        assert(m_keys.empty() || m_config.filter == filter);
+        assert(m_keys.size() < FURI_CACHE_KEY_MAX_QUERY_KEYS);
+        m_keys.push_back(key.c_sv());
+        m_config.filter = filter;
+        return *this;
+    }
+
+    // calls f with inline scratch space and retries with enough for all items of the uri if it fails
+    template <typename F>
+    auto with_scratch(opt_string_view uri, F f) const -> decltype(f(nullptr, 0))
+    {
+        std::array<capi::furi_query_iter_value, inline_items> items;
+        auto ret = f(items.data(), inline_items);
+        if (ret) return ret;
+        std::vector<capi::furi_query_iter_value> more(size_t(std::count(uri.begin(), uri.end(), '&')) + 1);
+        return f(more.data(), uint32_t(more.size()));
+    }
+
+    capi::furi_cache_key_config m_config = {};
+    std::vector<capi::furi_sv> m_keys;
+};
+
+}
@@ -4,8 +4,43 @@
 #pragma once
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <assert.h>
 
+///////////////////////////////////////////////////////////////////////////////
+// simd engine selection
+// the character search engine is picked at build time from the target flags
+// define FURI_NO_SIMD to force the scalar engine
+// on gcc and clang for x86 an avx2 engine is also compiled and selected at runtime with cpuid
+// define FURI_NO_SIMD_DISPATCH to disable this (for example for targets without cpuid)
+#if !defined(FURI_NO_SIMD)
+#   if defined(__AVX2__)
+#       define FURI_SIMD_AVX2 1
+#   endif
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define FURI_SIMD_SSE2 1
+#   endif
+#   if defined(__SSSE3__) || defined(__AVX2__)
+#       define FURI_SIMD_SSSE3 1
+#   endif
+#   if !defined(FURI_SIMD_AVX2) && !defined(FURI_NO_SIMD_DISPATCH) && defined(FURI_SIMD_SSE2) \
+        && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#       define FURI_SIMD_AVX2_DISPATCH 1
+#   endif
+#endif
+
+#if defined(FURI_SIMD_AVX2) || defined(FURI_SIMD_AVX2_DISPATCH)
+#   include <immintrin.h>
+#elif defined(FURI_SIMD_SSSE3)
+#   include <tmmintrin.h>
+#elif defined(FURI_SIMD_SSE2)
+#   include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#endif
+
 #if defined(__cplusplus)
 #   define FURI_EMPTY_VAL {}
 #   define FURI_EMPTY_T(T) {}
@@ -15,10 +50,12 @@
         extern "C" {
 #   endif
 #define FURI_INLINE inline
+#define FURI_TABLE static constexpr // tables are also usable in c++ constant expressions
 #else
 #define FURI_EMPTY_VAL {0}
 #define FURI_EMPTY_T(T) (T){0}
 #define FURI_INLINE static inline
+#define FURI_TABLE static const
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -112,6 +149,240 @@ FURI_INLINE const char* furi_sv_find_last(furi_sv sv, char q)
     // return (const char*)memrchr(sv.begin, q, len);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// bits
+// index of the lowest set bit of a non-zero mask (also of simd compare masks)
+FURI_INLINE int furi_ctz32(uint32_t mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward(&i, mask);
+    return (int)i;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+FURI_INLINE int furi_ctz64(uint64_t mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long i;
+    _BitScanForward64(&i, mask);
+    return (int)i;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    uint32_t lo = (uint32_t)mask;
+    return lo ? furi_ctz32(lo) : 32 + furi_ctz32((uint32_t)(mask >> 32));
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// character search engine
+// finds the first occurrence of either of two characters in [p, end)
+// returns NULL if neither is found
+
+FURI_INLINE const char* furi_find2_scalar(const char* p, const char* end, char a, char b)
+{
+    for (; p != end; ++p)
+    {
+        if (*p == a || *p == b) return p;
+    }
+    return NULL;
+}
+
+#if defined(FURI_SIMD_SSE2)
+FURI_INLINE const char* furi_find2_sse2(const char* p, const char* end, char a, char b)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    for (; end - p >= 16; p += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb));
+        unsigned mask = (unsigned)_mm_movemask_epi8(eq);
+        if (mask) return p + furi_ctz32(mask);
+    }
+    return furi_find2_scalar(p, end, a, b);
+}
+#endif
+
+#if defined(FURI_SIMD_AVX2) || defined(FURI_SIMD_AVX2_DISPATCH)
+#if defined(FURI_SIMD_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+#endif
+FURI_INLINE const char* furi_find2_avx2(const char* p, const char* end, char a, char b)
+{
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    for (; end - p >= 32; p += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(eq);
+        if (mask) return p + furi_ctz32(mask);
+    }
+    return furi_find2_sse2(p, end, a, b); // tail of less than 32 bytes
+}
+#endif
+
+#if defined(FURI_SIMD_AVX2_DISPATCH)
+FURI_INLINE bool furi_simd_cpu_has_avx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+FURI_INLINE const char* furi_find2(const char* p, const char* end, char a, char b)
+{
+#if defined(FURI_SIMD_AVX2)
+    return furi_find2_avx2(p, end, a, b);
+#elif defined(FURI_SIMD_SSE2)
+#   if defined(FURI_SIMD_AVX2_DISPATCH)
+    // only pay for the cpu check if there is something to gain
+    if (end - p >= 32 && furi_simd_cpu_has_avx2()) return furi_find2_avx2(p, end, a, b);
+#   endif
+    return furi_find2_sse2(p, end, a, b);
+#else
+    return furi_find2_scalar(p, end, a, b);
+#endif
+}
+
+// name of the engine used by furi_find2 on this machine: "avx2", "sse2", or "scalar"
+FURI_INLINE const char* furi_simd_engine_name(void)
+{
+#if defined(FURI_SIMD_AVX2)
+    return "avx2";
+#elif defined(FURI_SIMD_SSE2)
+#   if defined(FURI_SIMD_AVX2_DISPATCH)
+    if (furi_simd_cpu_has_avx2()) return "avx2";
+#   endif
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+FURI_INLINE const char* furi_sv_find_first_of2(furi_sv sv, char a, char b)
+{
+    return furi_find2(sv.begin, sv.end, a, b);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ascii case-insensitive comparison
+// only 'A'-'Z' are folded to 'a'-'z', all other bytes (including non-ascii) are compared as they are
+// the simd engines fold whole blocks of both strings and compare them
+
+FURI_INLINE char furi_ascii_tolower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c | 0x20) : c;
+}
+
+// furi_ascii_tolower of 8 bytes at a time
+FURI_INLINE uint64_t furi_ascii_tolower8(uint64_t w)
+{
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t high = 0x8080808080808080ull;
+    uint64_t low7 = w & ~high;
+    uint64_t ge_a = low7 + (0x80 - 'A') * ones; // high bit set if the low 7 bits are >= 'A'
+    uint64_t gt_z = low7 + (0x7F - 'Z') * ones; // high bit set if the low 7 bits are > 'Z'
+    uint64_t upper = (ge_a ^ gt_z) & ~w & high;
+    return w | (upper >> 2);
+}
+
+FURI_INLINE size_t furi_ascii_mismatch_scalar(const char* a, const char* b, size_t i, size_t n)
+{
+    for (; n - i >= 8; i += 8)
+    {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        if (furi_ascii_tolower8(wa) != furi_ascii_tolower8(wb)) break;
+    }
+    for (; i < n; ++i)
+    {
+        if (furi_ascii_tolower(a[i]) != furi_ascii_tolower(b[i])) return i;
+    }
+    return n;
+}
+
+#if defined(FURI_SIMD_SSE2)
+FURI_INLINE __m128i furi_ascii_tolower16(__m128i v)
+{
+    // 'A'-'Z' are shifted to the bottom of the signed range and checked with a single compare
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+FURI_INLINE size_t furi_ascii_mismatch_sse2(const char* a, const char* b, size_t i, size_t n)
+{
+    for (; n - i >= 16; i += 16)
+    {
+        __m128i va = furi_ascii_tolower16(_mm_loadu_si128((const __m128i*)(a + i)));
+        __m128i vb = furi_ascii_tolower16(_mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFF;
+        if (mask) return i + furi_ctz32(mask);
+    }
+    return furi_ascii_mismatch_scalar(a, b, i, n);
+}
+#endif
+
+#if defined(FURI_SIMD_AVX2) || defined(FURI_SIMD_AVX2_DISPATCH)
+#if defined(FURI_SIMD_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+#endif
+FURI_INLINE size_t furi_ascii_mismatch_avx2(const char* a, const char* b, size_t i, size_t n)
+{
+    const __m256i bias = _mm256_set1_epi8((char)(0x80 - 'A'));
+    const __m256i limit = _mm256_set1_epi8((char)(0x80 + 26));
+    const __m256i bit = _mm256_set1_epi8(0x20);
+    for (; n - i >= 32; i += 32)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        va = _mm256_or_si256(va, _mm256_and_si256(_mm256_cmpgt_epi8(limit, _mm256_add_epi8(va, bias)), bit));
+        vb = _mm256_or_si256(vb, _mm256_and_si256(_mm256_cmpgt_epi8(limit, _mm256_add_epi8(vb, bias)), bit));
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        if (mask) return i + furi_ctz32(mask);
+    }
+    return furi_ascii_mismatch_sse2(a, b, i, n); // tail of less than 32 bytes
+}
+#endif
+
+// index of the first of the n bytes of a and b which differ when case-folded or n if there is none
+FURI_INLINE size_t furi_ascii_mismatch(const char* a, const char* b, size_t n)
+{
+#if defined(FURI_SIMD_AVX2)
+    return furi_ascii_mismatch_avx2(a, b, 0, n);
+#elif defined(FURI_SIMD_SSE2)
+#   if defined(FURI_SIMD_AVX2_DISPATCH)
+    if (n >= 32 && furi_simd_cpu_has_avx2()) return furi_ascii_mismatch_avx2(a, b, 0, n);
+#   endif
+    return furi_ascii_mismatch_sse2(a, b, 0, n);
+#else
+    return furi_ascii_mismatch_scalar(a, b, 0, n);
+#endif
+}
+
+// like furi_sv_cmp (null and empty are equal) but comparing case-folded bytes
+FURI_INLINE int furi_sv_icmp(furi_sv a, furi_sv b)
+{
+    size_t alen = furi_sv_length(a);
+    size_t blen = furi_sv_length(b);
+    size_t n = alen < blen ? alen : blen;
+    size_t i = furi_ascii_mismatch(a.begin, b.begin, n);
+    if (i < n) return (int)(unsigned char)furi_ascii_tolower(a.begin[i]) - (int)(unsigned char)furi_ascii_tolower(b.begin[i]);
+    return (alen > blen) - (alen < blen);
+}
+
+FURI_INLINE bool furi_sv_iequals(furi_sv a, furi_sv b)
+{
+    size_t len = furi_sv_length(a);
+    if (len != furi_sv_length(b)) return false;
+    return furi_ascii_mismatch(a.begin, b.begin, len) == len;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // uri split
 typedef struct furi_uri_split
@@ -128,8 +399,28 @@ typedef struct furi_uri_split
     furi_sv req_path;
 } furi_uri_split;
 
-
-FURI_INLINE furi_uri_split furi_split_uri(furi_sv u)
+// flags which select components of a split
+typedef enum furi_uri_component
+{
+    FURI_URI_SCHEME = 1,
+    FURI_URI_AUTHORITY = 2,
+    FURI_URI_PATH = 4,
+    FURI_URI_QUERY = 8,
+    FURI_URI_FRAGMENT = 16,
+    FURI_URI_REQ_PATH = 32,
+    FURI_URI_ALL = 63,
+
+    // authority parts (only used to report validation errors)
+    FURI_URI_USERINFO = 64,
+    FURI_URI_HOST = 128,
+    FURI_URI_PORT = 256
+} furi_uri_component;
+
+
+// reference implementation
+// walks the input one byte at a time
+// furi_split_uri must produce identical results
+FURI_INLINE furi_uri_split furi_split_uri_scalar(furi_sv u)
 {
     furi_uri_split ret = FURI_EMPTY_VAL;
 
@@ -217,6 +508,147 @@ FURI_INLINE furi_uri_split furi_split_uri(furi_sv u)
     return ret;
 }
 
+// path, query, and fragment phases of furi_split_uri
+// u is the uri with scheme and authority sliced off and p is where to start searching in it
+FURI_INLINE void furi_split_uri_tail(furi_uri_split* ret, furi_sv u, const char* p)
+{
+    ret->req_path = u;
+    ret->path = u;
+
+    // path phase
+    p = furi_find2(p, u.end, '?', '#');
+    if (!p) return;
+
+    ret->path = furi_make_sv(u.begin, p);
+    if (*p == '#')
+    {
+        // fragment with no query
+        ret->fragment = furi_make_sv(p + 1, u.end);
+        return;
+    }
+
+    // query phase
+    u.begin = p + 1;
+    ret->query = u;
+    p = furi_sv_find_first(u, '#');
+    if (p)
+    {
+        ret->query.end = p;
+        ret->fragment = furi_make_sv(p + 1, u.end);
+    }
+}
+
+// same as furi_split_uri_scalar, but each phase is a block search with furi_find2
+FURI_INLINE furi_uri_split furi_split_uri(furi_sv u)
+{
+    furi_uri_split ret = FURI_EMPTY_VAL;
+
+    // scheme phase: the first ':' before any '/' ends the scheme
+    const char* p = furi_find2(u.begin, u.end, ':', '/');
+    if (!p)
+    {
+        p = u.end;
+    }
+    else if (*p == ':')
+    {
+        // found scheme
+        ret.scheme = furi_make_sv(u.begin, p);
+        u = furi_make_sv(p + 1, u.end); // slice scheme off
+
+        // since we have a scheme, we can also search for authority
+        if (furi_sv_starts_with(u, "//"))
+        {
+            // authority found
+            u.begin += 2; // slice prefix off
+            const char* f = furi_sv_find_first(u, '/'); // skip till end of authority
+            if (!f)
+            {
+                // nothing more than authority
+                ret.authority = u;
+                ret.req_path = furi_make_sv_from_string("/");
+                return ret;
+            }
+
+            ret.authority = furi_make_sv(u.begin, f);
+            u.begin = f; // slice off authority
+        }
+
+        p = u.begin;
+    }
+    else
+    {
+        // there is no scheme. It was a path all along
+        ++p;
+    }
+
+    furi_split_uri_tail(&ret, u, p);
+    return ret;
+}
+
+// the same as furi_split_uri, but only the components in the furi_uri_component flags are set
+// (the rest are null) and the scan stops as soon as the last of them is known
+// with a constant mask the phases which aren't needed are compiled out
+FURI_INLINE furi_uri_split furi_split_uri_masked(furi_sv u, int components)
+{
+    const int tail = FURI_URI_PATH | FURI_URI_QUERY | FURI_URI_FRAGMENT; // the components after the path phase
+    furi_uri_split ret = FURI_EMPTY_VAL;
+
+    // scheme phase
+    const char* p = furi_find2(u.begin, u.end, ':', '/');
+    if (!p)
+    {
+        p = u.end;
+    }
+    else if (*p == ':')
+    {
+        if (components & FURI_URI_SCHEME) ret.scheme = furi_make_sv(u.begin, p);
+        if (!(components & (FURI_URI_AUTHORITY | FURI_URI_REQ_PATH | tail))) return ret;
+        u = furi_make_sv(p + 1, u.end);
+
+        if (furi_sv_starts_with(u, "//"))
+        {
+            u.begin += 2;
+            const char* f = furi_sv_find_first(u, '/');
+            if (!f)
+            {
+                if (components & FURI_URI_AUTHORITY) ret.authority = u;
+                if (components & FURI_URI_REQ_PATH) ret.req_path = furi_make_sv_from_string("/");
+                return ret;
+            }
+            if (components & FURI_URI_AUTHORITY) ret.authority = furi_make_sv(u.begin, f);
+            u.begin = f;
+        }
+
+        p = u.begin;
+    }
+    else
+    {
+        ++p;
+    }
+
+    if (components & FURI_URI_REQ_PATH) ret.req_path = u;
+    if (!(components & tail)) return ret;
+
+    // path phase
+    if (components & FURI_URI_PATH) ret.path = u;
+    p = furi_find2(p, u.end, '?', '#');
+    if (!p) return ret;
+    if (components & FURI_URI_PATH) ret.path.end = p;
+    if (*p == '#')
+    {
+        if (components & FURI_URI_FRAGMENT) ret.fragment = furi_make_sv(p + 1, u.end);
+        return ret;
+    }
+    if (!(components & (FURI_URI_QUERY | FURI_URI_FRAGMENT))) return ret;
+
+    // query phase
+    u.begin = p + 1;
+    p = furi_sv_find_first(u, '#');
+    if (components & FURI_URI_QUERY) ret.query = furi_make_sv(u.begin, p ? p : u.end);
+    if (p && (components & FURI_URI_FRAGMENT)) ret.fragment = furi_make_sv(p + 1, u.end);
+    return ret;
+}
+
 // individual getters
 
 FURI_INLINE furi_sv furi_get_scheme_from_uri(furi_sv u)
@@ -317,91 +749,563 @@ FURI_INLINE furi_sv furi_get_fragment_from_uri(furi_sv u)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// authority split
-typedef struct furi_authority_split
-{
-    furi_sv userinfo;
-    furi_sv host;
-    furi_sv port;
-} furi_authority_split;
+// scheme classification
+// maps a scheme to the id of a known scheme, case-insensitively
+// the lookup is a perfect hash of the length and the first and last chars (folded to lowercase)
+// followed by a single comparison, so it's O(1) on the scheme of a split and needs no extra scan
+// furi.hpp regenerates the slot table from the scheme table at compile time and checks that they match
 
-FURI_INLINE furi_authority_split furi_split_authority(furi_sv a)
+typedef enum furi_scheme_id
 {
-    furi_authority_split ret = FURI_EMPTY_VAL;
+    FURI_SCHEME_NONE, // null scheme
+    FURI_SCHEME_OTHER, // not a known scheme
+    FURI_SCHEME_HTTP,
+    FURI_SCHEME_HTTPS,
+    FURI_SCHEME_WS,
+    FURI_SCHEME_WSS,
+    FURI_SCHEME_FTP,
+    FURI_SCHEME_FTPS,
+    FURI_SCHEME_SFTP,
+    FURI_SCHEME_SSH,
+    FURI_SCHEME_FILE,
+    FURI_SCHEME_GIT,
+    FURI_SCHEME_TELNET,
+    FURI_SCHEME_LDAP,
+    FURI_SCHEME_LDAPS,
+    FURI_SCHEME_GOPHER,
+    FURI_SCHEME_RTSP,
+    FURI_SCHEME_SIP,
+    FURI_SCHEME_SIPS,
+    FURI_SCHEME_MQTT,
+    FURI_SCHEME_REDIS,
+    FURI_SCHEME_MAILTO,
+    FURI_SCHEME_DATA,
+    FURI_SCHEME_TEL,
+    FURI_SCHEME_URN,
+    FURI_SCHEME_COUNT
+} furi_scheme_id;
+
+typedef struct furi_scheme_info
+{
+    const char* name; // lowercase
+    uint8_t length;
+    uint16_t default_port; // 0 if the scheme has no default port
+} furi_scheme_info;
+
+#define FURI_SCHEME_MAX_LENGTH 6
+#define FURI_SCHEME_HASH_MUL 0x4565ADDBu
+#define FURI_SCHEME_HASH_BITS 5
+
+// indexed by furi_scheme_id
+FURI_TABLE furi_scheme_info furi_scheme_infos[FURI_SCHEME_COUNT] = {
+    {"", 0, 0}, {"", 0, 0},
+    {"http", 4, 80}, {"https", 5, 443}, {"ws", 2, 80}, {"wss", 3, 443},
+    {"ftp", 3, 21}, {"ftps", 4, 990}, {"sftp", 4, 22}, {"ssh", 3, 22},
+    {"file", 4, 0}, {"git", 3, 9418}, {"telnet", 6, 23}, {"ldap", 4, 389},
+    {"ldaps", 5, 636}, {"gopher", 6, 70}, {"rtsp", 4, 554}, {"sip", 3, 5060},
+    {"sips", 4, 5061}, {"mqtt", 4, 1883}, {"redis", 5, 6379}, {"mailto", 6, 0},
+    {"data", 4, 0}, {"tel", 3, 0}, {"urn", 3, 0},
+};
+
+// furi_scheme_id of each hash slot (0 for empty slots)
+FURI_TABLE uint8_t furi_scheme_slots[1 << FURI_SCHEME_HASH_BITS] = {
+    0, 13, 0, 9, 19, 5, 10, 23, 0, 21, 0, 14, 6, 16, 2, 12,
+    11, 17, 0, 0, 0, 22, 7, 20, 3, 0, 8, 18, 4, 0, 15, 24,
+};
+
+// slot of a non-empty scheme of at most FURI_SCHEME_MAX_LENGTH chars
+FURI_INLINE uint32_t furi_scheme_slot(uint32_t length, char first, char last)
+{
+    uint32_t key = length | (uint32_t)(unsigned char)(first | 0x20) << 8 | (uint32_t)(unsigned char)(last | 0x20) << 16;
+    return (uint32_t)(key * FURI_SCHEME_HASH_MUL) >> (32 - FURI_SCHEME_HASH_BITS);
+}
 
-    const char* f = furi_sv_find_first(a, '@');
-    if (f)
+FURI_INLINE furi_scheme_id furi_classify_scheme(furi_sv scheme)
+{
+    if (!scheme.begin) return FURI_SCHEME_NONE;
+    size_t len = furi_sv_length(scheme);
+    if (!len || len > FURI_SCHEME_MAX_LENGTH) return FURI_SCHEME_OTHER;
+
+    uint8_t id = furi_scheme_slots[furi_scheme_slot((uint32_t)len, scheme.begin[0], scheme.end[-1])];
+    const furi_scheme_info* info = furi_scheme_infos + id;
+    if (info->length != len) return FURI_SCHEME_OTHER; // also empty slots
+    for (size_t i = 0; i < len; ++i)
     {
-        ret.userinfo = furi_make_sv(a.begin, f);
-        a.begin = f + 1; // slice userinfo off
+        if (furi_ascii_tolower(scheme.begin[i]) != info->name[i]) return FURI_SCHEME_OTHER;
     }
+    return (furi_scheme_id)id;
+}
 
-    // premptively set host
-    // will update if needed
-    ret.host = a;
+// 0 for schemes with no default port (including unknown ones)
+FURI_INLINE uint16_t furi_scheme_default_port(furi_scheme_id id)
+{
+    return furi_scheme_infos[id].default_port;
+}
 
-    if (furi_sv_is_empty(a)) return ret; // empty host
+// "" for FURI_SCHEME_NONE and FURI_SCHEME_OTHER
+FURI_INLINE const char* furi_scheme_name(furi_scheme_id id)
+{
+    return furi_scheme_infos[id].name;
+}
 
-    // check for ipv6
-    if (a.begin[0] == '[')
-    {
-        const char* bf = furi_sv_find_first(a, ']');
-        if (!bf) return FURI_EMPTY_T(furi_authority_split); // invalid uri
-        ++bf; // include the ']'
-        ret.host.end = bf;
-        a.begin = bf; // slice off
-        if (furi_sv_is_empty(a)) return ret; // valid. no port
-        if (a.begin[0] != ':') return FURI_EMPTY_T(furi_authority_split); // invalid uri
-        ret.port = furi_make_sv(a.begin + 1, a.end);
-        return ret;
-    }
+///////////////////////////////////////////////////////////////////////////////
+// batch uri split
+// splits many uris, writing each component into its own column of offsets and lengths
+// offsets are relative to the beginning of the uri they were split from
 
-    // no ipv6
-    // continue looking for port
+#define FURI_OFFSET_NULL UINT32_MAX // the component is null
+#define FURI_OFFSET_ROOT (UINT32_MAX - 1) // the req_path "/" of a uri which is nothing more than authority
 
-    for (const char* p = a.begin; p != a.end; ++p)
+typedef struct furi_sv_column
+{
+    // arrays of at least as many elements as there are uris
+    // if offsets is null, the column is skipped
+    uint32_t* offsets;
+    uint32_t* lengths;
+} furi_sv_column;
+
+typedef struct furi_uri_split_columns
+{
+    furi_sv_column scheme;
+    furi_sv_column authority;
+    furi_sv_column path;
+    furi_sv_column query;
+    furi_sv_column fragment;
+    furi_sv_column req_path;
+} furi_uri_split_columns;
+
+FURI_INLINE void furi_sv_column_set(furi_sv_column c, size_t i, furi_sv uri, furi_sv v)
+{
+    if (!c.offsets) return;
+    if (v.begin)
     {
-        if (*p == ':')
-        {
-            // found port
-            ret.host = furi_make_sv(a.begin, p);
-            ret.port = furi_make_sv(p + 1, a.end);
-            break;
-        }
+        c.offsets[i] = (uint32_t)(v.begin - uri.begin);
+        c.lengths[i] = (uint32_t)furi_sv_length(v);
+    }
+    else
+    {
+        c.offsets[i] = FURI_OFFSET_NULL;
+        c.lengths[i] = 0;
     }
-
-    return ret;
 }
 
-// individual getters
+// the value of an offset and length of a column
+FURI_INLINE furi_sv furi_sv_column_value(uint32_t off, uint32_t len, furi_sv uri)
+{
+    if (off == FURI_OFFSET_NULL) return FURI_EMPTY_T(furi_sv);
+    if (off == FURI_OFFSET_ROOT) return furi_make_sv_from_string("/");
+    return furi_make_sv(uri.begin + off, uri.begin + off + len);
+}
 
-FURI_INLINE furi_sv furi_get_userinfo_from_authority(furi_sv a)
+// the column must not be skipped
+FURI_INLINE furi_sv furi_sv_column_get(furi_sv_column c, size_t i, furi_sv uri)
 {
-    const char* p = furi_sv_find_first(a, '@');
-    if (!p) return FURI_EMPTY_T(furi_sv);
-    a.end = p;
-    return a;
+    return furi_sv_column_value(c.offsets[i], c.lengths[i], uri);
 }
 
-FURI_INLINE furi_sv furi_get_host_from_authority(furi_sv a)
+FURI_INLINE void furi_uri_split_columns_set(const furi_uri_split_columns* out, size_t i, furi_sv uri, const furi_uri_split* s)
 {
-    const char* p = furi_sv_find_first(a, '@');
-    if (p) a.begin = p + 1; // cut the @ symbol as well
-    p = furi_sv_find_first(a, ']');; // ipv6 check
-    if (p)
+    furi_sv_column_set(out->scheme, i, uri, s->scheme);
+    furi_sv_column_set(out->authority, i, uri, s->authority);
+    furi_sv_column_set(out->path, i, uri, s->path);
+    furi_sv_column_set(out->query, i, uri, s->query);
+    furi_sv_column_set(out->fragment, i, uri, s->fragment);
+    if (out->req_path.offsets && !s->path.begin && s->req_path.begin)
     {
-        a.end = p + 1;
-        return a;
+        // no path, but req_path: this is the "/" which doesn't point into the uri
+        out->req_path.offsets[i] = FURI_OFFSET_ROOT;
+        out->req_path.lengths[i] = 1;
+    }
+    else
+    {
+        furi_sv_column_set(out->req_path, i, uri, s->req_path);
     }
-    p = furi_sv_find_first(a, ':');
-    if (p) a.end = p;
-    return a;
 }
 
-FURI_INLINE furi_sv furi_get_port_from_authority(furi_sv a)
+FURI_INLINE furi_uri_split furi_uri_split_columns_get(const furi_uri_split_columns* cols, size_t i, furi_sv uri)
 {
-    const char* p = furi_sv_find_first(a, '@'); // skip userinfo if any
-    if (p) a.begin = p + 1;
+    furi_uri_split ret = FURI_EMPTY_VAL;
+    if (cols->scheme.offsets) ret.scheme = furi_sv_column_get(cols->scheme, i, uri);
+    if (cols->authority.offsets) ret.authority = furi_sv_column_get(cols->authority, i, uri);
+    if (cols->path.offsets) ret.path = furi_sv_column_get(cols->path, i, uri);
+    if (cols->query.offsets) ret.query = furi_sv_column_get(cols->query, i, uri);
+    if (cols->fragment.offsets) ret.fragment = furi_sv_column_get(cols->fragment, i, uri);
+    if (cols->req_path.offsets) ret.req_path = furi_sv_column_get(cols->req_path, i, uri);
+    return ret;
+}
+
+// there is no dependency between iterations, so splits of consecutive uris can overlap in the pipeline
+// uris must be shorter than 4 GB
+FURI_INLINE void furi_split_uri_batch(const furi_sv* in, size_t n, furi_uri_split_columns out)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        furi_uri_split s = furi_split_uri(in[i]);
+        furi_uri_split_columns_set(&out, i, in[i], &s);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// compact uri split
+// stores the layout of a split uri as offsets relative to its beginning (24 bytes)
+// the layout is the one produced by furi_split_uri:
+//  * scheme is [0, scheme_end)
+//  * authority is [scheme_end + 3, path_begin) (after "scheme://")
+//  * path is [path_begin, path_end)
+//  * query is [path_end + 1, query_end)
+//  * fragment is from one after the end of the query (or path if no query) to the end
+//  * req_path is [path_begin, length) or "/" if there is no path
+// uris must be shorter than 4 GB
+typedef struct furi_uri_split_compact
+{
+    uint32_t scheme_end;
+    uint32_t path_begin;
+    uint32_t path_end;
+    uint32_t query_end;
+    uint32_t length;
+    uint8_t flags; // furi_uri_component flags of the non-null components
+} furi_uri_split_compact;
+
+FURI_INLINE furi_uri_split_compact furi_uri_split_to_compact(const furi_uri_split* s, furi_sv uri)
+{
+    furi_uri_split_compact ret = FURI_EMPTY_VAL;
+    ret.length = (uint32_t)furi_sv_length(uri);
+    ret.path_begin = ret.length;
+    ret.path_end = ret.length;
+
+    if (s->scheme.begin)
+    {
+        ret.flags |= FURI_URI_SCHEME;
+        ret.scheme_end = (uint32_t)(s->scheme.end - uri.begin);
+    }
+    if (s->authority.begin)
+    {
+        ret.flags |= FURI_URI_AUTHORITY;
+        ret.path_begin = (uint32_t)(s->authority.end - uri.begin);
+        ret.path_end = ret.path_begin;
+    }
+    if (s->path.begin)
+    {
+        ret.flags |= FURI_URI_PATH;
+        ret.path_begin = (uint32_t)(s->path.begin - uri.begin);
+        ret.path_end = (uint32_t)(s->path.end - uri.begin);
+    }
+    ret.query_end = ret.path_end;
+    if (s->query.begin)
+    {
+        ret.flags |= FURI_URI_QUERY;
+        ret.query_end = (uint32_t)(s->query.end - uri.begin);
+    }
+    if (s->fragment.begin) ret.flags |= FURI_URI_FRAGMENT;
+    if (s->req_path.begin) ret.flags |= FURI_URI_REQ_PATH;
+
+    return ret;
+}
+
+FURI_INLINE furi_uri_split_compact furi_split_uri_compact(furi_sv u)
+{
+    furi_uri_split s = furi_split_uri(u);
+    return furi_uri_split_to_compact(&s, u);
+}
+
+FURI_INLINE furi_sv furi_uri_split_compact_get(const furi_uri_split_compact* c, const char* base, furi_uri_component component)
+{
+    if (!(c->flags & component)) return FURI_EMPTY_T(furi_sv);
+
+    switch (component)
+    {
+    case FURI_URI_SCHEME:
+        return furi_make_sv(base, base + c->scheme_end);
+    case FURI_URI_AUTHORITY:
+        return furi_make_sv(base + c->scheme_end + 3, base + c->path_begin);
+    case FURI_URI_PATH:
+        return furi_make_sv(base + c->path_begin, base + c->path_end);
+    case FURI_URI_QUERY:
+        return furi_make_sv(base + c->path_end + 1, base + c->query_end);
+    case FURI_URI_FRAGMENT:
+        return furi_make_sv(base + c->query_end + 1, base + c->length);
+    case FURI_URI_REQ_PATH:
+        if (!(c->flags & FURI_URI_PATH)) return furi_make_sv_from_string("/");
+        return furi_make_sv(base + c->path_begin, base + c->length);
+    default:
+        return FURI_EMPTY_T(furi_sv);
+    }
+}
+
+FURI_INLINE furi_uri_split furi_uri_split_from_compact(const furi_uri_split_compact* c, const char* base)
+{
+    furi_uri_split ret = {
+        furi_uri_split_compact_get(c, base, FURI_URI_SCHEME),
+        furi_uri_split_compact_get(c, base, FURI_URI_AUTHORITY),
+        furi_uri_split_compact_get(c, base, FURI_URI_PATH),
+        furi_uri_split_compact_get(c, base, FURI_URI_QUERY),
+        furi_uri_split_compact_get(c, base, FURI_URI_FRAGMENT),
+        furi_uri_split_compact_get(c, base, FURI_URI_REQ_PATH),
+    };
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// streaming uri split
+// splits a uri which arrives in chunks without buffering it
+// the result is the compact split of the concatenated chunks
+// (offsets are relative to the beginning of the first chunk)
+// boundaries are set in the compact split as soon as they are known,
+// so a component can be used before the rest of the uri has arrived
+
+typedef enum furi_uri_stream_phase
+{
+    FURI_URI_STREAM_SCHEME, // searching for ':' or '/'
+    FURI_URI_STREAM_AUTHORITY_PREFIX, // after "scheme:", matching "//"
+    FURI_URI_STREAM_AUTHORITY,
+    FURI_URI_STREAM_PATH,
+    FURI_URI_STREAM_QUERY,
+    FURI_URI_STREAM_FRAGMENT,
+    FURI_URI_STREAM_DONE
+} furi_uri_stream_phase;
+
+typedef struct furi_uri_stream
+{
+    furi_uri_split_compact split; // length is the number of bytes fed so far
+    uint8_t phase; // furi_uri_stream_phase
+    uint8_t prefix_slashes; // number of '/' of the authority prefix matched so far
+    uint8_t complete; // furi_uri_component flags of the components whose boundaries are final
+} furi_uri_stream;
+
+FURI_INLINE furi_uri_stream furi_make_uri_stream(void)
+{
+    furi_uri_stream ret = FURI_EMPTY_VAL;
+    return ret;
+}
+
+// returns the furi_uri_component flags of the components which were completed by this chunk
+FURI_INLINE int furi_uri_stream_feed(furi_uri_stream* st, furi_sv chunk)
+{
+    const uint8_t complete_before = st->complete;
+    const uint32_t base = st->split.length; // offset of chunk.begin
+    furi_uri_split_compact* s = &st->split;
+
+    const char* p = chunk.begin;
+    while (p != chunk.end)
+    {
+        const char* f;
+        switch (st->phase)
+        {
+        case FURI_URI_STREAM_SCHEME:
+            f = furi_find2(p, chunk.end, ':', '/');
+            if (!f)
+            {
+                p = chunk.end;
+                break;
+            }
+            if (*f == ':')
+            {
+                s->scheme_end = base + (uint32_t)(f - chunk.begin);
+                s->flags |= FURI_URI_SCHEME;
+                st->complete |= FURI_URI_SCHEME;
+                st->phase = FURI_URI_STREAM_AUTHORITY_PREFIX;
+            }
+            else
+            {
+                // there is no scheme. It was a path all along
+                st->complete |= FURI_URI_SCHEME | FURI_URI_AUTHORITY;
+                st->phase = FURI_URI_STREAM_PATH;
+            }
+            p = f + 1;
+            break;
+        case FURI_URI_STREAM_AUTHORITY_PREFIX:
+            if (*p == '/')
+            {
+                ++p;
+                if (++st->prefix_slashes == 2)
+                {
+                    s->flags |= FURI_URI_AUTHORITY;
+                    st->phase = FURI_URI_STREAM_AUTHORITY;
+                }
+                break;
+            }
+            // no authority
+            // the path starts after the colon, but whatever we've matched so far can't be a query or fragment
+            s->path_begin = s->scheme_end + 1;
+            st->complete |= FURI_URI_AUTHORITY;
+            st->phase = FURI_URI_STREAM_PATH;
+            break;
+        case FURI_URI_STREAM_AUTHORITY:
+            f = furi_sv_find_first(furi_make_sv(p, chunk.end), '/');
+            if (!f)
+            {
+                p = chunk.end;
+                break;
+            }
+            s->path_begin = base + (uint32_t)(f - chunk.begin);
+            st->complete |= FURI_URI_AUTHORITY;
+            st->phase = FURI_URI_STREAM_PATH;
+            p = f + 1;
+            break;
+        case FURI_URI_STREAM_PATH:
+            f = furi_find2(p, chunk.end, '?', '#');
+            if (!f)
+            {
+                p = chunk.end;
+                break;
+            }
+            s->path_end = base + (uint32_t)(f - chunk.begin);
+            s->query_end = s->path_end;
+            s->flags |= FURI_URI_PATH | FURI_URI_REQ_PATH;
+            st->complete |= FURI_URI_PATH;
+            if (*f == '?')
+            {
+                s->flags |= FURI_URI_QUERY;
+                st->phase = FURI_URI_STREAM_QUERY;
+            }
+            else
+            {
+                s->flags |= FURI_URI_FRAGMENT;
+                st->complete |= FURI_URI_QUERY;
+                st->phase = FURI_URI_STREAM_FRAGMENT;
+            }
+            p = f + 1;
+            break;
+        case FURI_URI_STREAM_QUERY:
+            f = furi_sv_find_first(furi_make_sv(p, chunk.end), '#');
+            if (!f)
+            {
+                p = chunk.end;
+                break;
+            }
+            s->query_end = base + (uint32_t)(f - chunk.begin);
+            s->flags |= FURI_URI_FRAGMENT;
+            st->complete |= FURI_URI_QUERY;
+            st->phase = FURI_URI_STREAM_FRAGMENT;
+            p = f + 1;
+            break;
+        default:
+            // fragment: nothing more to search
+            p = chunk.end;
+            break;
+        }
+    }
+
+    s->length += (uint32_t)furi_sv_length(chunk);
+    return st->complete & ~complete_before;
+}
+
+// completes the split after the last chunk
+FURI_INLINE furi_uri_split_compact furi_uri_stream_finish(furi_uri_stream* st)
+{
+    furi_uri_split_compact* s = &st->split;
+    switch (st->phase)
+    {
+    case FURI_URI_STREAM_AUTHORITY:
+        // nothing more than authority
+        s->path_begin = s->path_end = s->query_end = s->length;
+        s->flags |= FURI_URI_REQ_PATH;
+        break;
+    case FURI_URI_STREAM_AUTHORITY_PREFIX:
+        s->path_begin = s->scheme_end + 1;
+        // fallthrough
+    case FURI_URI_STREAM_SCHEME:
+    case FURI_URI_STREAM_PATH:
+        s->path_end = s->query_end = s->length;
+        s->flags |= FURI_URI_PATH | FURI_URI_REQ_PATH;
+        break;
+    case FURI_URI_STREAM_QUERY:
+        s->query_end = s->length;
+        break;
+    default:
+        break;
+    }
+    st->phase = FURI_URI_STREAM_DONE;
+    st->complete = FURI_URI_ALL;
+    return *s;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// authority split
+typedef struct furi_authority_split
+{
+    furi_sv userinfo;
+    furi_sv host;
+    furi_sv port;
+} furi_authority_split;
+
+FURI_INLINE furi_authority_split furi_split_authority(furi_sv a)
+{
+    furi_authority_split ret = FURI_EMPTY_VAL;
+
+    const char* f = furi_sv_find_first(a, '@');
+    if (f)
+    {
+        ret.userinfo = furi_make_sv(a.begin, f);
+        a.begin = f + 1; // slice userinfo off
+    }
+
+    // premptively set host
+    // will update if needed
+    ret.host = a;
+
+    if (furi_sv_is_empty(a)) return ret; // empty host
+
+    // check for ipv6
+    if (a.begin[0] == '[')
+    {
+        const char* bf = furi_sv_find_first(a, ']');
+        if (!bf) return FURI_EMPTY_T(furi_authority_split); // invalid uri
+        ++bf; // include the ']'
+        ret.host.end = bf;
+        a.begin = bf; // slice off
+        if (furi_sv_is_empty(a)) return ret; // valid. no port
+        if (a.begin[0] != ':') return FURI_EMPTY_T(furi_authority_split); // invalid uri
+        ret.port = furi_make_sv(a.begin + 1, a.end);
+        return ret;
+    }
+
+    // no ipv6
+    // continue looking for port
+
+    for (const char* p = a.begin; p != a.end; ++p)
+    {
+        if (*p == ':')
+        {
+            // found port
+            ret.host = furi_make_sv(a.begin, p);
+            ret.port = furi_make_sv(p + 1, a.end);
+            break;
+        }
+    }
+
+    return ret;
+}
+
+// individual getters
+
+FURI_INLINE furi_sv furi_get_userinfo_from_authority(furi_sv a)
+{
+    const char* p = furi_sv_find_first(a, '@');
+    if (!p) return FURI_EMPTY_T(furi_sv);
+    a.end = p;
+    return a;
+}
+
+FURI_INLINE furi_sv furi_get_host_from_authority(furi_sv a)
+{
+    const char* p = furi_sv_find_first(a, '@');
+    if (p) a.begin = p + 1; // cut the @ symbol as well
+    p = furi_sv_find_first(a, ']');; // ipv6 check
+    if (p)
+    {
+        a.end = p + 1;
+        return a;
+    }
+    p = furi_sv_find_first(a, ':');
+    if (p) a.end = p;
+    return a;
+}
+
+FURI_INLINE furi_sv furi_get_port_from_authority(furi_sv a)
+{
+    const char* p = furi_sv_find_first(a, '@'); // skip userinfo if any
+    if (p) a.begin = p + 1;
     p = furi_sv_find_first(a, ']'); // skip ipv6 if any
     if (p) a.begin = p + 1;
     p = furi_sv_find_first(a, ':'); // find port separator
@@ -447,6 +1351,130 @@ FURI_INLINE furi_sv furi_get_password_from_userinfo(furi_sv ui)
     return ui;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// full decomposition
+// the same results as furi_split_uri, followed by furi_split_authority on the authority
+// and furi_split_userinfo on the userinfo, but in a single forward pass over the input
+typedef struct furi_uri_decomposition
+{
+    furi_uri_split uri;
+    furi_authority_split authority;
+    furi_userinfo_split userinfo;
+} furi_uri_decomposition;
+
+// scans an authority up to the first '/' or the end of u
+// splits it into as and us and returns the end of the authority
+FURI_INLINE const char* furi_scan_authority(furi_sv u, furi_authority_split* as, furi_userinfo_split* us)
+{
+    // the positions of ':' and ']' are recorded separately before and after the first '@'
+    // so we know them for both userinfo and host without scanning again
+    const char* at = NULL;
+    const char* colon = NULL;
+    const char* host_colon = NULL;
+    const char* bracket = NULL;
+    const char* host_bracket = NULL;
+
+    const char* p = u.begin;
+    for (; p != u.end; ++p)
+    {
+        char c = *p;
+        if (c == '/') break;
+        if (c == '@')
+        {
+            if (!at) at = p;
+        }
+        else if (c == ':')
+        {
+            if (at) { if (!host_colon) host_colon = p; }
+            else if (!colon) colon = p;
+        }
+        else if (c == ']')
+        {
+            if (at) { if (!host_bracket) host_bracket = p; }
+            else if (!bracket) bracket = p;
+        }
+    }
+
+    furi_sv h = furi_make_sv(u.begin, p);
+    if (at)
+    {
+        as->userinfo = furi_make_sv(u.begin, at);
+        us->username = as->userinfo;
+        if (colon)
+        {
+            us->username.end = colon;
+            us->password = furi_make_sv(colon + 1, at);
+        }
+        h.begin = at + 1;
+        colon = host_colon;
+        bracket = host_bracket;
+    }
+
+    as->host = h;
+    if (furi_sv_is_empty(h)) return p; // empty host
+
+    if (h.begin[0] == '[')
+    {
+        // ipv6
+        if (!bracket || (bracket + 1 != h.end && bracket[1] != ':'))
+        {
+            // invalid uri
+            *as = FURI_EMPTY_T(furi_authority_split);
+            *us = FURI_EMPTY_T(furi_userinfo_split);
+            return p;
+        }
+        as->host.end = bracket + 1; // include the ']'
+        if (as->host.end != h.end) as->port = furi_make_sv(bracket + 2, h.end);
+        return p;
+    }
+
+    if (colon)
+    {
+        as->host.end = colon;
+        as->port = furi_make_sv(colon + 1, h.end);
+    }
+    return p;
+}
+
+FURI_INLINE furi_uri_decomposition furi_decompose_uri(furi_sv u)
+{
+    furi_uri_decomposition ret = FURI_EMPTY_VAL;
+
+    const char* p = furi_find2(u.begin, u.end, ':', '/');
+    if (!p)
+    {
+        p = u.end;
+    }
+    else if (*p == ':')
+    {
+        ret.uri.scheme = furi_make_sv(u.begin, p);
+        u = furi_make_sv(p + 1, u.end);
+
+        if (furi_sv_starts_with(u, "//"))
+        {
+            u.begin += 2;
+            const char* f = furi_scan_authority(u, &ret.authority, &ret.userinfo);
+            ret.uri.authority = furi_make_sv(u.begin, f);
+            if (f == u.end)
+            {
+                // nothing more than authority
+                ret.uri.req_path = furi_make_sv_from_string("/");
+                return ret;
+            }
+            u.begin = f;
+        }
+
+        p = u.begin;
+    }
+    else
+    {
+        ++p;
+    }
+
+    furi_split_uri_tail(&ret.uri, u, p);
+    return ret;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // path iterator
 typedef struct furi_path_iter
@@ -500,6 +1528,70 @@ FURI_INLINE bool furi_path_iter_equal(const furi_path_iter a, const furi_path_it
     return a.begin == b.begin;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// host label iterator
+// iterates the labels of a host from right to left: "www.example.com" is "com", "example", "www"
+// a trailing '.' (of a fully qualified name) is skipped, so "example.com." has the same labels
+// "" and "." have no labels and empty labels are kept: "a..b" is "b", "", "a"
+// the host is not checked, so ip addresses are split too
+typedef struct furi_host_label_iter
+{
+    const char* range_begin;
+    const char* begin; // current label
+    const char* end; // NULL when done
+} furi_host_label_iter;
+
+FURI_INLINE furi_host_label_iter furi_make_host_label_iter_end(const furi_sv host)
+{
+    furi_host_label_iter ret = {host.begin, NULL, NULL};
+    return ret;
+}
+
+// moves to the label which ends at end
+FURI_INLINE void furi_host_label_iter_set(furi_host_label_iter* hi, const char* end)
+{
+    const char* p = end;
+    while (p != hi->range_begin && p[-1] != '.') --p;
+    hi->begin = p;
+    hi->end = end;
+}
+
+FURI_INLINE void furi_host_label_iter_next(furi_host_label_iter* hi)
+{
+    if (hi->begin == hi->range_begin)
+    {
+        hi->begin = NULL;
+        hi->end = NULL;
+        return;
+    }
+    furi_host_label_iter_set(hi, hi->begin - 1); // skip the '.'
+}
+
+FURI_INLINE furi_host_label_iter furi_make_host_label_iter_begin(const furi_sv host)
+{
+    furi_host_label_iter ret = furi_make_host_label_iter_end(host);
+    if (furi_sv_is_empty(host)) return ret;
+    const char* end = host.end;
+    if (end[-1] == '.' && --end == host.begin) return ret;
+    furi_host_label_iter_set(&ret, end);
+    return ret;
+}
+
+FURI_INLINE bool furi_host_label_iter_is_done(const furi_host_label_iter hi)
+{
+    return !hi.end;
+}
+
+FURI_INLINE furi_sv furi_host_label_iter_get_value(const furi_host_label_iter hi)
+{
+    return furi_make_sv(hi.begin, hi.end);
+}
+
+FURI_INLINE bool furi_host_label_iter_equal(const furi_host_label_iter a, const furi_host_label_iter b)
+{
+    return a.end == b.end;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // query iterator
 #define FURI_QUERY_KV_SEP '='
@@ -576,6 +1668,940 @@ FURI_INLINE bool furi_query_iter_equal(const furi_query_iter a, const furi_query
     return a.begin == b.begin;
 }
 
+// the same items as furi_query_iter, but the separators are found with furi_find2
+// scans the item which begins at begin (the beginning of the query or one after an item separator)
+// returns the separator at the end of the item or NULL if it's the last one
+FURI_INLINE const char* furi_query_scan_item(const char* begin, const char* end, furi_query_iter_value* item)
+{
+    // the key ends at the last key-value separator of the item
+    const char* kv_sep = NULL;
+    const char* p = begin;
+    for (;; ++p)
+    {
+        p = furi_find2(p, end, FURI_QUERY_KV_SEP, FURI_QUERY_ITEM_SEP);
+        if (!p || *p == FURI_QUERY_ITEM_SEP) break;
+        kv_sep = p;
+    }
+
+    const char* item_end = p ? p : end;
+    if (kv_sep)
+    {
+        item->key = furi_make_sv(begin, kv_sep);
+        item->value = furi_make_sv(kv_sep + 1, item_end);
+    }
+    else
+    {
+        item->key = furi_make_sv(begin, item_end);
+        item->value = FURI_EMPTY_T(furi_sv);
+    }
+    return p;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// query index
+// a hash index of the items of a query, built in a single pass
+// the items are the same as the ones of furi_query_iter
+// keys are compared as they are in the query (not percent decoded)
+// repeated keys are chained in query order
+// storage is provided by the caller: see furi_query_index_storage for a small inline one
+#define FURI_QUERY_INDEX_NONE UINT32_MAX
+
+typedef struct furi_query_index_item
+{
+    furi_sv key;
+    furi_sv value;
+    uint32_t hash;
+    uint32_t next; // index of the next item with the same key or FURI_QUERY_INDEX_NONE
+} furi_query_index_item;
+
+// one slot per distinct key
+typedef struct furi_query_index_slot
+{
+    uint32_t first; // first item with the key or FURI_QUERY_INDEX_NONE if the slot is empty
+    uint32_t last;
+} furi_query_index_slot;
+
+typedef struct furi_query_index
+{
+    furi_query_index_item* items;
+    furi_query_index_slot* slots;
+    uint32_t capacity; // max number of items
+    uint32_t slot_mask; // number of slots - 1
+    uint32_t size; // number of indexed items
+    bool truncated; // the query has more than capacity items and only the first ones are indexed
+} furi_query_index;
+
+// 64-bit hash of a string view, word at a time
+// with fold strings which are equal with furi_sv_iequals have the same hash
+// the values are not stable across platforms
+FURI_INLINE uint64_t furi_sv_hash64(furi_sv s, bool fold)
+{
+    const char* p = s.begin;
+    size_t len = furi_sv_length(s);
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ len;
+    for (; len >= 8; len -= 8, p += 8)
+    {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        if (fold) w = furi_ascii_tolower8(w);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    uint64_t w = 0;
+    for (size_t i = 0; i < len; ++i) w |= (uint64_t)(unsigned char)p[i] << (i * 8);
+    if (fold) w = furi_ascii_tolower8(w);
+    h = (h ^ w) * 0x94D049BB133111EBull;
+    h ^= h >> 29;
+    return h;
+}
+
+FURI_INLINE uint32_t furi_sv_hash(furi_sv s)
+{
+    return (uint32_t)(furi_sv_hash64(s, false) >> 32);
+}
+
+// case-insensitive furi_sv_hash
+FURI_INLINE uint32_t furi_sv_ihash(furi_sv s)
+{
+    return (uint32_t)(furi_sv_hash64(s, true) >> 32);
+}
+
+// the number of slots to pass for a capacity: a power of two at least twice as big
+FURI_INLINE uint32_t furi_query_index_slot_count(uint32_t capacity)
+{
+    uint32_t ret = 2;
+    while (ret < capacity * 2) ret *= 2;
+    return ret;
+}
+
+// slot_count must be a power of two greater than capacity (see furi_query_index_slot_count)
+FURI_INLINE furi_query_index furi_make_query_index(furi_query_index_item* items, uint32_t capacity,
+    furi_query_index_slot* slots, uint32_t slot_count)
+{
+    assert(slot_count > capacity && (slot_count & (slot_count - 1)) == 0);
+    furi_query_index ret = {items, slots, capacity, slot_count - 1, 0, false};
+    return ret;
+}
+
+FURI_INLINE bool furi_query_index_item_has_key(const furi_query_index_item* item, furi_sv key, uint32_t hash)
+{
+    size_t len = furi_sv_length(key);
+    return item->hash == hash && furi_sv_length(item->key) == len && (!len || memcmp(item->key.begin, key.begin, len) == 0);
+}
+
+// the slot of key: either the one with its items or the empty one where it would be
+FURI_INLINE furi_query_index_slot* furi_query_index_probe(const furi_query_index* idx, furi_sv key, uint32_t hash)
+{
+    for (uint32_t i = hash & idx->slot_mask; ; i = (i + 1) & idx->slot_mask)
+    {
+        furi_query_index_slot* slot = idx->slots + i;
+        if (slot->first == FURI_QUERY_INDEX_NONE) return slot;
+        if (furi_query_index_item_has_key(idx->items + slot->first, key, hash)) return slot;
+    }
+}
+
+// indexes the items of query, replacing any previous contents
+FURI_INLINE void furi_query_index_build(furi_query_index* idx, furi_sv query)
+{
+    idx->size = 0;
+    idx->truncated = false;
+    if (furi_sv_is_empty(query)) return; // furi_query_index_find doesn't look at the slots of empty indices
+    memset(idx->slots, 0xFF, (idx->slot_mask + 1) * sizeof(furi_query_index_slot)); // FURI_QUERY_INDEX_NONE
+
+    const char* begin = query.begin;
+    for (;;)
+    {
+        furi_query_iter_value v;
+        const char* p = furi_query_scan_item(begin, query.end, &v);
+        if (idx->size == idx->capacity)
+        {
+            idx->truncated = true;
+            return;
+        }
+
+        uint32_t n = idx->size++;
+        furi_query_index_item* item = idx->items + n;
+        item->key = v.key;
+        item->value = v.value;
+        item->hash = furi_sv_hash(item->key);
+        item->next = FURI_QUERY_INDEX_NONE;
+
+        furi_query_index_slot* slot = furi_query_index_probe(idx, item->key, item->hash);
+        if (slot->first == FURI_QUERY_INDEX_NONE) slot->first = n;
+        else idx->items[slot->last].next = n;
+        slot->last = n;
+
+        if (!p) return;
+        begin = p + 1;
+    }
+}
+
+// first item with key or NULL if there is none
+FURI_INLINE const furi_query_index_item* furi_query_index_find(const furi_query_index* idx, furi_sv key)
+{
+    if (!idx->size || furi_sv_is_null(key)) return NULL; // keys are never null
+    const furi_query_index_slot* slot = furi_query_index_probe(idx, key, furi_sv_hash(key));
+    if (slot->first == FURI_QUERY_INDEX_NONE) return NULL;
+    return idx->items + slot->first;
+}
+
+// next item with the same key as item or NULL if there is none
+FURI_INLINE const furi_query_index_item* furi_query_index_find_next(const furi_query_index* idx, const furi_query_index_item* item)
+{
+    if (item->next == FURI_QUERY_INDEX_NONE) return NULL;
+    return idx->items + item->next;
+}
+
+// number of items with key
+FURI_INLINE uint32_t furi_query_index_count(const furi_query_index* idx, furi_sv key)
+{
+    uint32_t ret = 0;
+    for (const furi_query_index_item* i = furi_query_index_find(idx, key); i; i = furi_query_index_find_next(idx, i)) ++ret;
+    return ret;
+}
+
+// inline storage for small queries
+#define FURI_QUERY_INDEX_INLINE_CAPACITY 32
+
+typedef struct furi_query_index_storage
+{
+    furi_query_index_item items[FURI_QUERY_INDEX_INLINE_CAPACITY];
+    furi_query_index_slot slots[FURI_QUERY_INDEX_INLINE_CAPACITY * 2];
+} furi_query_index_storage;
+
+FURI_INLINE furi_query_index furi_make_query_index_from_storage(furi_query_index_storage* storage)
+{
+    return furi_make_query_index(storage->items, FURI_QUERY_INDEX_INLINE_CAPACITY,
+        storage->slots, FURI_QUERY_INDEX_INLINE_CAPACITY * 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// multi-key query extraction
+// finds the first item of each of a fixed set of up to 64 keys in a single scan of a query
+// and stops as soon as all are found
+// items are the same as the ones of furi_query_iter and keys are compared as they are in the query
+// a filter of the first chars and lengths of the wanted keys rejects most other items
+// without comparing them to each key
+#define FURI_QUERY_EXTRACT_MAX_KEYS 64
+
+typedef struct furi_query_key_filter
+{
+    uint64_t first_chars[4]; // bit c is set if a key begins with the char c
+    uint64_t lengths; // bit n is set if a key has length n (bit 63 for 63 or longer)
+} furi_query_key_filter;
+
+FURI_INLINE uint64_t furi_query_key_filter_length_bit(size_t len)
+{
+    return 1ull << (len < 63 ? len : 63);
+}
+
+FURI_INLINE void furi_query_key_filter_add(furi_query_key_filter* filter, furi_sv key)
+{
+    size_t len = furi_sv_length(key);
+    filter->lengths |= furi_query_key_filter_length_bit(len);
+    if (len)
+    {
+        unsigned char c = (unsigned char)key.begin[0];
+        filter->first_chars[c >> 6] |= 1ull << (c & 63);
+    }
+}
+
+FURI_INLINE furi_query_key_filter furi_make_query_key_filter(const furi_sv* keys, uint32_t count)
+{
+    furi_query_key_filter ret = FURI_EMPTY_VAL;
+    for (uint32_t i = 0; i < count; ++i) furi_query_key_filter_add(&ret, keys[i]);
+    return ret;
+}
+
+FURI_INLINE bool furi_query_key_filter_has_first_char(const furi_query_key_filter* filter, char c)
+{
+    unsigned char uc = (unsigned char)c;
+    return (filter->first_chars[uc >> 6] >> (uc & 63)) & 1;
+}
+
+FURI_INLINE bool furi_query_key_filter_match(const furi_query_key_filter* filter, furi_sv key)
+{
+    size_t len = furi_sv_length(key);
+    if (!(filter->lengths & furi_query_key_filter_length_bit(len))) return false;
+    return !len || furi_query_key_filter_has_first_char(filter, key.begin[0]);
+}
+
+// out must have room for count items
+// out[i] is the first item with keys[i] or null if there is none
+// returns the number of keys found
+FURI_INLINE uint32_t furi_query_extract(furi_sv query, const furi_sv* keys, uint32_t count,
+    const furi_query_key_filter* filter, furi_query_iter_value* out)
+{
+    assert(count <= FURI_QUERY_EXTRACT_MAX_KEYS);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        furi_query_iter_value empty = FURI_EMPTY_VAL;
+        out[i] = empty;
+    }
+    if (!count || furi_sv_is_empty(query)) return 0;
+
+    uint64_t missing = count == 64 ? ~0ull : (1ull << count) - 1;
+    uint32_t found = 0;
+    const char* begin = query.begin;
+    for (;;)
+    {
+        // the first char of an item is the first char of its key, unless the key is empty
+        // so unless an empty key is wanted, items with other first chars are skipped
+        // without looking for key-value separators in them
+        if (!(filter->lengths & 1) && begin != query.end && !furi_query_key_filter_has_first_char(filter, *begin))
+        {
+            const char* p = furi_find2(begin, query.end, FURI_QUERY_ITEM_SEP, FURI_QUERY_ITEM_SEP);
+            if (!p) return found;
+            begin = p + 1;
+            continue;
+        }
+
+        furi_query_iter_value item;
+        const char* p = furi_query_scan_item(begin, query.end, &item);
+        if (furi_query_key_filter_match(filter, item.key))
+        {
+            // duplicate wanted keys all get the item
+            for (uint64_t m = missing; m; m &= m - 1)
+            {
+                int i = furi_ctz64(m);
+                if (furi_sv_cmp(keys[i], item.key) != 0) continue;
+                out[i] = item;
+                missing &= ~(1ull << i);
+                ++found;
+            }
+            if (!missing) return found;
+        }
+
+        if (!p) return found;
+        begin = p + 1;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// percent decoding
+// decodes %XX escapes of any component (path segment, query key or value, etc)
+// invalid or truncated escapes are copied as they are
+// optionally decodes '+' as space (for application/x-www-form-urlencoded data)
+// the decoded string is never longer than the input
+
+FURI_INLINE int furi_hex_digit_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20; // to lower
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+FURI_INLINE const char* furi_pct_find_next(const char* p, const char* end, bool plus_as_space)
+{
+    if (plus_as_space) return furi_find2(p, end, '%', '+');
+    return furi_sv_find_first(furi_make_sv(p, end), '%');
+}
+
+FURI_INLINE bool furi_sv_needs_pct_decoding(furi_sv sv, bool plus_as_space)
+{
+    return !!furi_pct_find_next(sv.begin, sv.end, plus_as_space);
+}
+
+// out must have room for at least furi_sv_length(in) chars
+// out can be the same as in.begin for in-place decoding
+// returns the decoded string in out
+FURI_INLINE furi_sv furi_pct_decode(furi_sv in, char* out, bool plus_as_space)
+{
+    if (furi_sv_is_null(in)) return FURI_EMPTY_T(furi_sv);
+
+    char* o = out;
+    const char* p = in.begin;
+    while (true)
+    {
+        const char* f = furi_pct_find_next(p, in.end, plus_as_space);
+
+        // copy the run with nothing to decode in bulk
+        size_t run = (f ? f : in.end) - p;
+        if (run && o != p) memmove(o, p, run);
+        o += run;
+
+        if (!f) break;
+
+        if (*f == '+')
+        {
+            *o++ = ' ';
+            p = f + 1;
+            continue;
+        }
+
+        if (in.end - f >= 3)
+        {
+            int hi = furi_hex_digit_value(f[1]);
+            int lo = furi_hex_digit_value(f[2]);
+            if (hi >= 0 && lo >= 0)
+            {
+                *o++ = (char)(hi * 16 + lo);
+                p = f + 3;
+                continue;
+            }
+        }
+
+        // invalid escape
+        *o++ = '%';
+        p = f + 1;
+    }
+
+    return furi_make_sv(out, o);
+}
+
+FURI_INLINE furi_sv furi_pct_decode_in_place(char* begin, char* end, bool plus_as_space)
+{
+    return furi_pct_decode(furi_make_sv(begin, end), begin, plus_as_space);
+}
+
+// returns in itself if there is nothing to decode, otherwise decodes into buf
+// buf must have room for at least furi_sv_length(in) chars
+FURI_INLINE furi_sv furi_pct_decode_if_needed(furi_sv in, char* buf, bool plus_as_space)
+{
+    const char* f = furi_pct_find_next(in.begin, in.end, plus_as_space);
+    if (!f) return in;
+
+    // skip the prefix we already know to have nothing to decode
+    size_t prefix = f - in.begin;
+    memcpy(buf, in.begin, prefix);
+    furi_sv rest = furi_pct_decode(furi_make_sv(f, in.end), buf + prefix, plus_as_space);
+    return furi_make_sv(buf, rest.end);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// character classes (RFC 3986)
+typedef enum furi_char_class
+{
+    FURI_CC_SCHEME, // ALPHA DIGIT + - .
+    FURI_CC_USERINFO, // unreserved sub-delims : (also the contents of ip literals)
+    FURI_CC_REG_NAME, // unreserved sub-delims
+    FURI_CC_PATH, // unreserved sub-delims : @ /
+    FURI_CC_QUERY, // unreserved sub-delims : @ / ? (also fragment)
+    FURI_CC_PORT, // DIGIT
+    FURI_CC_ALPHA,
+    FURI_CC_UNRESERVED // ALPHA DIGIT - . _ ~
+} furi_char_class;
+
+// bit (1 << furi_char_class) is set for each class the char belongs to
+// '%' is not in any class. Percent escapes are checked separately
+FURI_TABLE uint8_t furi_char_class_table[256] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x1e, 0x00, 0x00, 0x1e, 0x00, 0x1e, 0x1e, 0x1e, 0x1e, 0x1e, 0x1f, 0x1e, 0x9f, 0x9f, 0x18,
+    0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0xbf, 0x1a, 0x1e, 0x00, 0x1e, 0x00, 0x10,
+    0x18, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf,
+    0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0x00, 0x00, 0x00, 0x00, 0x9e,
+    0x00, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf,
+    0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0xdf, 0x00, 0x00, 0x00, 0x9e, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// the same classes for nibble lookups:
+// c is in class cc if furi_char_class_nibbles[cc][c & 0xF] & (1 << (c >> 4))
+FURI_TABLE uint8_t furi_char_class_nibbles[8][16] = {
+    {0xa8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf0, 0x54, 0x50, 0x54, 0x54, 0x50}, // scheme
+    {0xa8, 0xfc, 0xf8, 0xf8, 0xfc, 0xf8, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x5c, 0x54, 0x5c, 0xd4, 0x70}, // userinfo
+    {0xa8, 0xfc, 0xf8, 0xf8, 0xfc, 0xf8, 0xfc, 0xfc, 0xfc, 0xfc, 0xf4, 0x5c, 0x54, 0x5c, 0xd4, 0x70}, // reg_name
+    {0xb8, 0xfc, 0xf8, 0xf8, 0xfc, 0xf8, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x5c, 0x54, 0x5c, 0xd4, 0x74}, // path
+    {0xb8, 0xfc, 0xf8, 0xf8, 0xfc, 0xf8, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x5c, 0x54, 0x5c, 0xd4, 0x7c}, // query
+    {0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // port
+    {0xa0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x50, 0x50, 0x50, 0x50, 0x50}, // alpha
+    {0xa8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf0, 0x50, 0x50, 0x54, 0xd4, 0x70}, // unreserved
+};
+FURI_TABLE uint8_t furi_hex_digit_nibbles[16] = {
+    0x08, 0x58, 0x58, 0x58, 0x58, 0x58, 0x58, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+FURI_INLINE bool furi_char_is(char c, furi_char_class cc)
+{
+    return (furi_char_class_table[(unsigned char)c] >> cc) & 1;
+}
+
+// length of the valid char or percent escape at p or 0 if it's invalid
+FURI_INLINE int furi_valid_char_length(const char* p, const char* end, furi_char_class cc, bool pct)
+{
+    if (furi_char_is(*p, cc)) return 1;
+    if (pct && *p == '%' && end - p >= 3 && furi_hex_digit_value(p[1]) >= 0 && furi_hex_digit_value(p[2]) >= 0) return 3;
+    return 0;
+}
+
+// find the first char in [p, end) which is not in the class cc (or a valid percent escape if pct is true)
+// returns NULL if all are valid
+// pct must only be set for classes which contain the hex digits (all but alpha and port)
+
+FURI_INLINE const char* furi_find_invalid_char_scalar(const char* p, const char* end, furi_char_class cc, bool pct)
+{
+    while (p != end)
+    {
+        int len = furi_valid_char_length(p, end, cc, pct);
+        if (!len) return p;
+        p += len;
+    }
+    return NULL;
+}
+
+// the simd engines classify blocks with two nibble lookups
+// percent escapes which fit in the block are also matched there and
+// only the remaining flagged chars are checked further
+// the last block of each range is loaded so that it ends at the end and overlaps the checked ones
+
+#if defined(FURI_SIMD_SSSE3) || defined(FURI_SIMD_AVX2_DISPATCH)
+// bit i of the result is set if p[i] is not in the class of lo_table
+#if !defined(FURI_SIMD_SSSE3)
+__attribute__((target("ssse3")))
+#endif
+FURI_INLINE unsigned furi_char_class_mask16(const char* p, __m128i lo_table, bool pct)
+{
+    const __m128i hi_table = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i lo_nibbles = _mm_and_si128(v, nibble_mask);
+    __m128i hi = _mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+    __m128i lo = _mm_shuffle_epi8(lo_table, lo_nibbles);
+    unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero));
+    if (!mask || !pct) return mask;
+
+    __m128i hex = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)furi_hex_digit_nibbles), lo_nibbles);
+    unsigned hex_mask = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(hex, hi), zero)) & 0xFFFF;
+    unsigned pct_mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('%')));
+    return mask & ~(pct_mask & (hex_mask >> 1) & (hex_mask >> 2));
+}
+
+// checks the chars at p flagged in mask
+FURI_INLINE const char* furi_check_flagged_chars(const char* p, const char* end, unsigned mask, furi_char_class cc, bool pct)
+{
+    for (; mask; mask &= mask - 1)
+    {
+        const char* q = p + furi_ctz32(mask);
+        if (!furi_valid_char_length(q, end, cc, pct)) return q;
+    }
+    return NULL;
+}
+#endif
+
+#if defined(FURI_SIMD_SSSE3)
+FURI_INLINE const char* furi_find_invalid_char_ssse3(const char* p, const char* end, furi_char_class cc, bool pct)
+{
+    if (end - p < 16) return furi_find_invalid_char_scalar(p, end, cc, pct);
+    const __m128i lo_table = _mm_loadu_si128((const __m128i*)furi_char_class_nibbles[cc]);
+    const char* last = end - 16;
+    for (; p < last; p += 16)
+    {
+        unsigned mask = furi_char_class_mask16(p, lo_table, pct);
+        const char* q = mask ? furi_check_flagged_chars(p, end, mask, cc, pct) : NULL;
+        if (q) return q;
+    }
+    unsigned mask = furi_char_class_mask16(last, lo_table, pct) >> (p - last);
+    return mask ? furi_check_flagged_chars(p, end, mask, cc, pct) : NULL;
+}
+#endif
+
+#if defined(FURI_SIMD_AVX2) || defined(FURI_SIMD_AVX2_DISPATCH)
+#if defined(FURI_SIMD_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+#endif
+FURI_INLINE const char* furi_find_invalid_char_avx2(const char* p, const char* end, furi_char_class cc, bool pct)
+{
+    if (end - p < 16) return furi_find_invalid_char_scalar(p, end, cc, pct);
+    const __m128i lo_table16 = _mm_loadu_si128((const __m128i*)furi_char_class_nibbles[cc]);
+    if (end - p < 32)
+    {
+        const char* last = end - 16;
+        unsigned mask = furi_char_class_mask16(p, lo_table16, pct) | (furi_char_class_mask16(last, lo_table16, pct) << (last - p));
+        return mask ? furi_check_flagged_chars(p, end, mask, cc, pct) : NULL;
+    }
+
+    const __m256i lo_table = _mm256_broadcastsi128_si256(lo_table16);
+    const __m256i hi_table = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i hex_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)furi_hex_digit_nibbles));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i percent = _mm256_set1_epi8('%');
+    const __m256i zero = _mm256_setzero_si256();
+    const char* last = end - 32;
+    for (;;)
+    {
+        const char* block = p < last ? p : last;
+        __m256i v = _mm256_loadu_si256((const __m256i*)block);
+        __m256i lo_nibbles = _mm256_and_si256(v, nibble_mask);
+        __m256i hi = _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask));
+        __m256i lo = _mm256_shuffle_epi8(lo_table, lo_nibbles);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero));
+        if (mask && pct)
+        {
+            __m256i hex = _mm256_shuffle_epi8(hex_table, lo_nibbles);
+            unsigned hex_mask = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(hex, hi), zero));
+            unsigned pct_mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, percent));
+            mask &= ~(pct_mask & (hex_mask >> 1) & (hex_mask >> 2));
+        }
+        mask >>= p - block;
+        const char* q = mask ? furi_check_flagged_chars(p, end, mask, cc, pct) : NULL;
+        if (q || block == last) return q;
+        p += 32;
+    }
+}
+#endif
+
+FURI_INLINE const char* furi_find_invalid_char(const char* p, const char* end, furi_char_class cc, bool pct)
+{
+    assert(!pct || (cc != FURI_CC_ALPHA && cc != FURI_CC_PORT));
+#if defined(FURI_SIMD_AVX2)
+    return furi_find_invalid_char_avx2(p, end, cc, pct);
+#else
+#   if defined(FURI_SIMD_AVX2_DISPATCH)
+    if (end - p >= 16 && furi_simd_cpu_has_avx2()) return furi_find_invalid_char_avx2(p, end, cc, pct);
+#   endif
+#   if defined(FURI_SIMD_SSSE3)
+    return furi_find_invalid_char_ssse3(p, end, cc, pct);
+#   else
+    return furi_find_invalid_char_scalar(p, end, cc, pct);
+#   endif
+#endif
+}
+
+// same as furi_find_invalid_char for a short range [p, end) inside of the readable range r
+// the simd engines classify it with a single block load from r instead of walking it char by char
+#if defined(FURI_SIMD_SSSE3) || defined(FURI_SIMD_AVX2_DISPATCH)
+#if !defined(FURI_SIMD_SSSE3)
+__attribute__((target("ssse3")))
+#endif
+FURI_INLINE const char* furi_find_invalid_char_short(furi_sv r, const char* p, const char* end, furi_char_class cc, bool pct)
+{
+    const char* block = r.end - p < 16 ? r.end - 16 : p;
+    const __m128i lo_table = _mm_loadu_si128((const __m128i*)furi_char_class_nibbles[cc]);
+    int len = (int)(end - p);
+    unsigned mask = (furi_char_class_mask16(block, lo_table, pct) >> (p - block)) & ((1u << len) - 1);
+    // escapes are matched with the chars after end, so leave the ones at the end to furi_check_flagged_chars
+    if (pct && len >= 1 && end[-1] == '%') mask |= 1u << (len - 1);
+    if (pct && len >= 2 && end[-2] == '%') mask |= 1u << (len - 2);
+    return mask ? furi_check_flagged_chars(p, end, mask, cc, pct) : NULL;
+}
+#endif
+
+FURI_INLINE const char* furi_find_invalid_char_within(furi_sv r, const char* p, const char* end, furi_char_class cc, bool pct)
+{
+#if defined(FURI_SIMD_SSSE3)
+    if (end - p < 16 && furi_sv_length(r) >= 16) return furi_find_invalid_char_short(r, p, end, cc, pct);
+#elif defined(FURI_SIMD_AVX2_DISPATCH)
+    if (end - p < 16 && furi_sv_length(r) >= 16 && furi_simd_cpu_has_avx2()) return furi_find_invalid_char_short(r, p, end, cc, pct);
+#else
+    (void)r;
+#endif
+    return furi_find_invalid_char(p, end, cc, pct);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// strict validation
+// checks each component of a decomposed uri against its RFC 3986 character set
+// (including percent escapes), and that a scheme, if present, begins with a letter
+// the split itself is unchanged: validation is opt-in
+typedef struct furi_uri_violation
+{
+    int component; // furi_uri_component of the first violation or 0 if the uri is valid
+    size_t offset; // offset of the first invalid char in the uri
+} furi_uri_violation;
+
+FURI_INLINE bool furi_validate_component(furi_uri_violation* v, furi_sv uri, furi_sv comp,
+    int component, furi_char_class cc, bool pct)
+{
+    if (furi_sv_is_null(comp)) return true;
+    const char* p = furi_find_invalid_char_within(uri, comp.begin, comp.end, cc, pct);
+    if (!p) return true;
+    v->component = component;
+    v->offset = p - uri.begin;
+    return false;
+}
+
+// a is the split authority of s (ignored if s has no authority)
+FURI_INLINE furi_uri_violation furi_validate_split(const furi_uri_split* s, const furi_authority_split* a, furi_sv uri)
+{
+    furi_uri_violation ret = {0, 0};
+
+    furi_sv scheme = s->scheme;
+    if (scheme.begin)
+    {
+        if (furi_sv_is_empty(scheme) || !furi_char_is(scheme.begin[0], FURI_CC_ALPHA))
+        {
+            ret.component = FURI_URI_SCHEME;
+            ret.offset = scheme.begin - uri.begin;
+            return ret;
+        }
+        if (!furi_validate_component(&ret, uri, scheme, FURI_URI_SCHEME, FURI_CC_SCHEME, false)) return ret;
+    }
+
+    if (s->authority.begin)
+    {
+        furi_sv host = a->host;
+        if (!host.begin)
+        {
+            // furi_split_authority failed
+            ret.component = FURI_URI_HOST;
+            ret.offset = s->authority.begin - uri.begin;
+            return ret;
+        }
+
+        if (!furi_validate_component(&ret, uri, a->userinfo, FURI_URI_USERINFO, FURI_CC_USERINFO, true)) return ret;
+
+        if (!furi_sv_is_empty(host) && host.begin[0] == '[')
+        {
+            // ip literal: the split guarantees the closing bracket
+            furi_sv inner = furi_make_sv(host.begin + 1, host.end - 1);
+            if (!furi_validate_component(&ret, uri, inner, FURI_URI_HOST, FURI_CC_USERINFO, false)) return ret;
+        }
+        else if (!furi_validate_component(&ret, uri, host, FURI_URI_HOST, FURI_CC_REG_NAME, true)) return ret;
+
+        if (!furi_validate_component(&ret, uri, a->port, FURI_URI_PORT, FURI_CC_PORT, false)) return ret;
+    }
+
+    if (!furi_validate_component(&ret, uri, s->path, FURI_URI_PATH, FURI_CC_PATH, true)) return ret;
+    if (!furi_validate_component(&ret, uri, s->query, FURI_URI_QUERY, FURI_CC_QUERY, true)) return ret;
+    furi_validate_component(&ret, uri, s->fragment, FURI_URI_FRAGMENT, FURI_CC_QUERY, true);
+    return ret;
+}
+
+FURI_INLINE furi_uri_violation furi_validate_decomposition(const furi_uri_decomposition* d, furi_sv uri)
+{
+    return furi_validate_split(&d->uri, &d->authority, uri);
+}
+
+// validating split
+// returns the same as furi_split_uri and fills violation
+FURI_INLINE furi_uri_split furi_split_uri_strict(furi_sv u, furi_uri_violation* violation)
+{
+    furi_uri_split s = furi_split_uri(u);
+    furi_authority_split a = FURI_EMPTY_VAL;
+    if (s.authority.begin) a = furi_split_authority(s.authority);
+    *violation = furi_validate_split(&s, &a, u);
+    return s;
+}
+
+FURI_INLINE furi_uri_violation furi_validate_uri(furi_sv u)
+{
+    furi_uri_violation ret;
+    furi_split_uri_strict(u, &ret);
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// host and port decoding
+// binary values of hosts and ports, parsed directly from string views
+// none of these functions copy the input or depend on the locale
+
+// parses a dotted-decimal IPv4 address (RFC 3986 dec-octets: no leading zeros)
+// the result is in host byte order: 127.0.0.1 is 0x7F000001
+// returns false if s is not an IPv4 address
+FURI_INLINE bool furi_parse_ipv4(furi_sv s, uint32_t* out)
+{
+    size_t len = furi_sv_length(s);
+    if (len < 7 || len > 15) return false;
+
+    // classify all chars without branching:
+    // bit i of dots is set if s[i] is a dot, bad is set if anything is neither a dot nor a digit
+    uint32_t dots = 0;
+    unsigned bad = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned char c = (unsigned char)s.begin[i];
+        unsigned is_dot = c == '.';
+        dots |= is_dot << i;
+        bad |= !is_dot & ((unsigned)(c - '0') > 9);
+    }
+    if (bad) return false;
+
+    dots |= 1u << len; // the end terminates the last octet
+    uint32_t addr = 0;
+    int begin = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (!dots) return false; // too few octets
+        int end = furi_ctz32(dots);
+        dots &= dots - 1;
+        int n = end - begin;
+        if (n < 1 || n > 3) return false;
+        const unsigned char* d = (const unsigned char*)s.begin + begin;
+        if (n > 1 && d[0] == '0') return false; // leading zero
+        unsigned v = d[n - 1] - '0';
+        v += (n > 1 ? d[n - 2] - '0' : 0) * 10;
+        v += (n > 2 ? d[0] - '0' : 0) * 100;
+        if (v > 255) return false;
+        addr = (addr << 8) | v;
+        begin = end + 1;
+    }
+    if (dots) return false; // too many octets
+
+    *out = addr;
+    return true;
+}
+
+// parses a textual IPv6 address without brackets (RFC 4291 section 2.2, including a trailing IPv4 part)
+// zone identifiers are not supported
+// the result is in network byte order
+// returns false if s is not an IPv6 address
+FURI_INLINE bool furi_parse_ipv6(furi_sv s, uint8_t out[16])
+{
+    uint16_t groups[8];
+    int n = 0;
+    int gap = -1; // index in groups where "::" is
+    const char* p = s.begin;
+    const char* end = s.end;
+
+    if (end - p < 2) return false;
+    if (*p == ':')
+    {
+        if (p[1] != ':') return false;
+        gap = 0;
+        p += 2;
+    }
+
+    while (p != end)
+    {
+        if (n == 8) return false;
+
+        const char* q = p;
+        unsigned v = 0;
+        while (q != end && q - p < 4)
+        {
+            int h = furi_hex_digit_value(*q);
+            if (h < 0) break;
+            v = (v << 4) | (unsigned)h;
+            ++q;
+        }
+        if (q == p) return false;
+
+        if (q != end && *q == '.')
+        {
+            // trailing IPv4 part
+            uint32_t ipv4;
+            if (n > 6 || !furi_parse_ipv4(furi_make_sv(p, end), &ipv4)) return false;
+            groups[n++] = (uint16_t)(ipv4 >> 16);
+            groups[n++] = (uint16_t)ipv4;
+            p = end;
+            break;
+        }
+
+        groups[n++] = (uint16_t)v;
+        p = q;
+        if (p == end) break;
+        if (*p != ':') return false;
+        ++p;
+        if (p == end) return false; // trailing single ':'
+        if (*p == ':')
+        {
+            if (gap >= 0) return false; // second "::"
+            gap = n;
+            ++p;
+        }
+    }
+
+    if (gap < 0 ? n != 8 : n > 7) return false;
+
+    memset(out, 0, 16);
+    int tail = gap < 0 ? 0 : n - gap; // groups after the "::"
+    int head = n - tail;
+    for (int i = 0; i < head; ++i)
+    {
+        out[2 * i] = (uint8_t)(groups[i] >> 8);
+        out[2 * i + 1] = (uint8_t)groups[i];
+    }
+    for (int i = 0; i < tail; ++i)
+    {
+        int o = 2 * (8 - tail + i);
+        out[o] = (uint8_t)(groups[head + i] >> 8);
+        out[o + 1] = (uint8_t)groups[head + i];
+    }
+    return true;
+}
+
+// parses a port as returned by furi_split_authority
+// leading zeros are allowed
+// returns false for empty strings, non-digits, and values above 65535
+FURI_INLINE bool furi_parse_port(furi_sv s, uint16_t* out)
+{
+    const char* p = s.begin;
+    const char* end = s.end;
+    if (p == end) return false;
+    while (end - p > 5 && *p == '0') ++p;
+    size_t len = end - p;
+    if (len > 5) return false;
+
+    // swar: right-align the digits in a word of '0's and convert all 8 at once
+    // the first char goes in the lowest byte, regardless of the byte order of the machine
+    uint64_t w = 0x3030303030303030ull;
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned shift = (unsigned)(8 - len + i) * 8;
+        w = (w & ~(0xFFull << shift)) | ((uint64_t)(unsigned char)p[i] << shift);
+    }
+    // every byte must be a digit: its high nibble is 3 and adding 6 doesn't carry out of the low nibble
+    if (((w & 0xF0F0F0F0F0F0F0F0ull) | (((w + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) != 0x3333333333333333ull) return false;
+    w -= 0x3030303030303030ull;
+    w = (w * 10 + (w >> 8)) & 0x00FF00FF00FF00FFull;
+    w = (w * 100 + (w >> 16)) & 0x0000FFFF0000FFFFull;
+    w = (w * 10000 + (w >> 32)) & 0xFFFFFFFFull;
+    if (w > 65535) return false;
+
+    *out = (uint16_t)w;
+    return true;
+}
+
+typedef enum furi_host_kind
+{
+    FURI_HOST_INVALID, // null, or a malformed ip literal
+    FURI_HOST_REG_NAME,
+    FURI_HOST_IPV4,
+    FURI_HOST_IPV6,
+    FURI_HOST_IPVFUTURE,
+} furi_host_kind;
+
+typedef struct furi_host_address
+{
+    furi_host_kind kind;
+    uint32_t ipv4; // host byte order, only set for FURI_HOST_IPV4
+    uint8_t ipv6[16]; // network byte order, only set for FURI_HOST_IPV6
+} furi_host_address;
+
+// classifies and decodes a host as returned by furi_split_authority
+// ip literals are expected in brackets, but IPv6 addresses without them are also accepted
+// anything else which is not an IPv4 address is a reg-name
+FURI_INLINE furi_host_address furi_decode_host(furi_sv host)
+{
+    furi_host_address ret = FURI_EMPTY_VAL;
+    if (furi_sv_is_null(host)) return ret;
+
+    if (!furi_sv_is_empty(host) && host.begin[0] == '[')
+    {
+        if (furi_sv_length(host) < 2 || host.end[-1] != ']') return ret;
+        furi_sv lit = furi_make_sv(host.begin + 1, host.end - 1);
+        if (!furi_sv_is_empty(lit) && (lit.begin[0] | 0x20) == 'v')
+        {
+            // IPvFuture: "v" 1*HEXDIG "." 1*( unreserved / sub-delims / ":" )
+            const char* p = lit.begin + 1;
+            while (p != lit.end && furi_hex_digit_value(*p) >= 0) ++p;
+            if (p == lit.begin + 1 || p == lit.end || *p != '.' || p + 1 == lit.end) return ret;
+            if (furi_find_invalid_char(p + 1, lit.end, FURI_CC_USERINFO, false)) return ret;
+            ret.kind = FURI_HOST_IPVFUTURE;
+            return ret;
+        }
+        if (furi_parse_ipv6(lit, ret.ipv6)) ret.kind = FURI_HOST_IPV6;
+        return ret;
+    }
+
+    if (furi_parse_ipv4(host, &ret.ipv4)) ret.kind = FURI_HOST_IPV4;
+    else if (furi_parse_ipv6(host, ret.ipv6)) ret.kind = FURI_HOST_IPV6;
+    else ret.kind = FURI_HOST_REG_NAME;
+    return ret;
+}
+
 #if defined(__cplusplus)
 // dual purpose closing brace
 // if FURI_CPP_NAMESPACE is defined this closes the namespace
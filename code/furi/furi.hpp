@@ -5,10 +5,33 @@
 #include <string_view>
 #include <utility>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
 
 #define FURI_CPP_NAMESPACE furi::capi
 #include "furi.h"
 
+// the constexpr splits below use their native c++ implementations in constant evaluation
+// and the c ones (with simd) at run time
+// if the compiler can't tell the difference, the native ones are used for both
+#if defined(__cpp_lib_is_constant_evaluated)
+#   define FURI_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#   define FURI_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+#       define FURI_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#   endif
+#endif
+#if !defined(FURI_IS_CONSTANT_EVALUATED)
+#   define FURI_IS_CONSTANT_EVALUATED() true
+#endif
+
 namespace furi
 {
 // optional string view
@@ -16,30 +39,69 @@ namespace furi
 class opt_string_view : public std::string_view
 {
 public:
-    opt_string_view() noexcept = default;
-    opt_string_view(const char* cstring) noexcept // intentionally implicit
+    constexpr opt_string_view() noexcept = default;
+    constexpr opt_string_view(const char* cstring) noexcept // intentionally implicit
         : std::string_view(cstring) {}
     opt_string_view(const std::string& s) noexcept // intentionally implicit
         : std::string_view(s) {}
     constexpr opt_string_view(const std::string_view& str) noexcept // intentionally implicit
         : std::string_view(str) {}
-    opt_string_view(const char* begin, const char* end) noexcept
-        : std::string_view(begin, end - begin) {}
-    opt_string_view(const capi::furi_sv& csv) noexcept // intentionally implicit
+    constexpr opt_string_view(const char* begin, const char* end) noexcept
+        : std::string_view(begin, size_t(end - begin)) {}
+    constexpr opt_string_view(const capi::furi_sv& csv) noexcept // intentionally implicit
         : opt_string_view(csv.begin, csv.end) {}
 
-    [[nodiscard]] bool null() const noexcept { return !data(); }
+    [[nodiscard]] constexpr bool null() const noexcept { return !data(); }
 
-    [[nodiscard]] std::string_view value_or(std::string_view val) const noexcept {
+    [[nodiscard]] constexpr std::string_view value_or(std::string_view val) const noexcept {
         if (data()) return *this;
         return val;
     }
-    explicit operator bool() const noexcept { return !null(); }
+    constexpr explicit operator bool() const noexcept { return !null(); }
 
 
     [[nodiscard]] capi::furi_sv c_sv() const noexcept { return capi::furi_make_sv(data(), data() + size()); }
 };
 
+// ascii case-insensitive comparison (see capi::furi_sv_icmp)
+[[nodiscard]] inline bool iequals(opt_string_view a, opt_string_view b) noexcept
+{
+    return capi::furi_sv_iequals(a.c_sv(), b.c_sv());
+}
+
+[[nodiscard]] inline int icmp(opt_string_view a, opt_string_view b) noexcept
+{
+    return capi::furi_sv_icmp(a.c_sv(), b.c_sv());
+}
+
+// hashers and equality for unordered containers of strings
+// they are transparent, so with c++20 heterogeneous lookup a container of std::string
+// can be searched with views without allocating
+struct sv_hash
+{
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+};
+
+struct sv_equal
+{
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const noexcept { return a == b; }
+};
+
+// ascii case-insensitive: std::unordered_map<std::string, T, sv_ihash, sv_iequal>
+struct sv_ihash
+{
+    using is_transparent = void;
+    size_t operator()(opt_string_view s) const noexcept { return size_t(capi::furi_sv_hash64(s.c_sv(), true)); }
+};
+
+struct sv_iequal
+{
+    using is_transparent = void;
+    bool operator()(opt_string_view a, opt_string_view b) const noexcept { return iequals(a, b); }
+};
+
 struct uri_split
 {
     opt_string_view scheme;
@@ -49,7 +111,7 @@ struct uri_split
     opt_string_view fragment;
     opt_string_view req_path;
 
-    static uri_split from_capi(const capi::furi_uri_split& cs) noexcept
+    static constexpr uri_split from_capi(const capi::furi_uri_split& cs) noexcept
     {
         return {
             opt_string_view(cs.scheme),
@@ -61,9 +123,98 @@ struct uri_split
         };
     }
 
-    static uri_split from_uri(opt_string_view u) noexcept
+    static constexpr uri_split from_uri(opt_string_view u) noexcept
+    {
+        if (!FURI_IS_CONSTANT_EVALUATED()) return from_capi(capi::furi_split_uri(u.c_sv()));
+        return from_uri_native(u);
+    }
+
+    // only the components in the capi::furi_uri_component flags are set, the rest are null:
+    // uri_split::from_uri<capi::FURI_URI_PATH>(u)
+    // the scan stops as soon as the last of them is known
+    template <int Components>
+    static constexpr uri_split from_uri(opt_string_view u) noexcept
+    {
+        static_assert(Components > 0 && (Components & ~capi::FURI_URI_ALL) == 0, "invalid component flags");
+        if (!FURI_IS_CONSTANT_EVALUATED()) return from_capi(capi::furi_split_uri_masked(u.c_sv(), Components));
+        return from_uri_native(u).masked(Components);
+    }
+
+    // a copy with the components which are not in the flags set to null
+    constexpr uri_split masked(int components) const noexcept
     {
-        return from_capi(capi::furi_split_uri(u.c_sv()));
+        uri_split ret;
+        if (components & capi::FURI_URI_SCHEME) ret.scheme = scheme;
+        if (components & capi::FURI_URI_AUTHORITY) ret.authority = authority;
+        if (components & capi::FURI_URI_PATH) ret.path = path;
+        if (components & capi::FURI_URI_QUERY) ret.query = query;
+        if (components & capi::FURI_URI_FRAGMENT) ret.fragment = fragment;
+        if (components & capi::FURI_URI_REQ_PATH) ret.req_path = req_path;
+        return ret;
+    }
+
+    // the same as capi::furi_split_uri_scalar without the c api
+    static constexpr uri_split from_uri_native(opt_string_view u) noexcept
+    {
+        uri_split ret;
+
+        // scheme phase
+        size_t p = u.find_first_of(":/");
+        if (p == opt_string_view::npos)
+        {
+            p = u.size();
+        }
+        else if (u[p] == ':')
+        {
+            ret.scheme = u.substr(0, p);
+            u = u.substr(p + 1);
+
+            if (u.substr(0, 2) == "//")
+            {
+                u = u.substr(2);
+                size_t f = u.find('/');
+                if (f == opt_string_view::npos)
+                {
+                    // nothing more than authority
+                    ret.authority = u;
+                    ret.req_path = "/";
+                    return ret;
+                }
+                ret.authority = u.substr(0, f);
+                u = u.substr(f);
+            }
+
+            p = 0;
+        }
+        else
+        {
+            // there is no scheme. It was a path all along
+            ++p;
+        }
+
+        // path phase
+        ret.req_path = u;
+        ret.path = u;
+        p = u.find_first_of("?#", p);
+        if (p == opt_string_view::npos) return ret;
+
+        ret.path = u.substr(0, p);
+        if (u[p] == '#')
+        {
+            ret.fragment = u.substr(p + 1);
+            return ret;
+        }
+
+        // query phase
+        u = u.substr(p + 1);
+        ret.query = u;
+        p = u.find('#');
+        if (p != opt_string_view::npos)
+        {
+            ret.query = u.substr(0, p);
+            ret.fragment = u.substr(p + 1);
+        }
+        return ret;
     }
 
     static opt_string_view get_scheme_from_uri(opt_string_view u) noexcept
@@ -97,13 +248,168 @@ struct uri_split
     }
 };
 
+// offset-based split
+// the accessors need the beginning of the uri which was split
+struct uri_split_compact
+{
+    capi::furi_uri_split_compact c = {};
+
+    static uri_split_compact from_uri(opt_string_view u) noexcept
+    {
+        return {capi::furi_split_uri_compact(u.c_sv())};
+    }
+
+    static uri_split_compact from_split(const uri_split& s, opt_string_view u) noexcept
+    {
+        capi::furi_uri_split cs = {
+            s.scheme.c_sv(),
+            s.authority.c_sv(),
+            s.path.c_sv(),
+            s.query.c_sv(),
+            s.fragment.c_sv(),
+            s.req_path.c_sv(),
+        };
+        return {capi::furi_uri_split_to_compact(&cs, u.c_sv())};
+    }
+
+    [[nodiscard]] opt_string_view scheme(const char* base) const noexcept { return get(base, capi::FURI_URI_SCHEME); }
+    [[nodiscard]] opt_string_view authority(const char* base) const noexcept { return get(base, capi::FURI_URI_AUTHORITY); }
+    [[nodiscard]] opt_string_view path(const char* base) const noexcept { return get(base, capi::FURI_URI_PATH); }
+    [[nodiscard]] opt_string_view query(const char* base) const noexcept { return get(base, capi::FURI_URI_QUERY); }
+    [[nodiscard]] opt_string_view fragment(const char* base) const noexcept { return get(base, capi::FURI_URI_FRAGMENT); }
+    [[nodiscard]] opt_string_view req_path(const char* base) const noexcept { return get(base, capi::FURI_URI_REQ_PATH); }
+
+    [[nodiscard]] uri_split to_split(const char* base) const noexcept
+    {
+        return uri_split::from_capi(capi::furi_uri_split_from_compact(&c, base));
+    }
+
+private:
+    opt_string_view get(const char* base, capi::furi_uri_component comp) const noexcept
+    {
+        return opt_string_view(capi::furi_uri_split_compact_get(&c, base, comp));
+    }
+};
+
+// incremental split of a uri which arrives in chunks
+class uri_stream
+{
+    capi::furi_uri_stream m_st = capi::furi_make_uri_stream();
+public:
+    // returns the furi_uri_component flags of the components completed by this chunk
+    int feed(opt_string_view chunk) noexcept { return capi::furi_uri_stream_feed(&m_st, chunk.c_sv()); }
+
+    [[nodiscard]] int complete() const noexcept { return m_st.complete; }
+
+    // boundaries known so far (only valid for complete components)
+    [[nodiscard]] uri_split_compact current() const noexcept { return {m_st.split}; }
+
+    uri_split_compact finish() noexcept { return {capi::furi_uri_stream_finish(&m_st)}; }
+
+    const capi::furi_uri_stream& c_stream() const noexcept { return m_st; }
+};
+
+// column output of a batch split
+// only the components given to from_uris are filled, the rest are empty
+struct uri_split_columns
+{
+    struct column
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> lengths;
+
+        [[nodiscard]] bool enabled() const noexcept { return !offsets.empty(); }
+
+        // null for all uris if the column is not enabled
+        [[nodiscard]] opt_string_view get(size_t i, opt_string_view uri) const noexcept
+        {
+            if (!enabled()) return {};
+            return opt_string_view(capi::furi_sv_column_value(offsets[i], lengths[i], uri.c_sv()));
+        }
+
+        // the column for the c api to write to (skipped if not enabled)
+        [[nodiscard]] capi::furi_sv_column c_column() noexcept
+        {
+            if (!enabled()) return {nullptr, nullptr};
+            return {offsets.data(), lengths.data()};
+        }
+    };
+
+    column scheme;
+    column authority;
+    column path;
+    column query;
+    column fragment;
+    column req_path;
+
+    std::size_t size() const noexcept { return m_size; }
+
+    [[nodiscard]] capi::furi_uri_split_columns c_columns() noexcept
+    {
+        return {
+            scheme.c_column(),
+            authority.c_column(),
+            path.c_column(),
+            query.c_column(),
+            fragment.c_column(),
+            req_path.c_column(),
+        };
+    }
+
+    [[nodiscard]] uri_split at(size_t i, opt_string_view uri) const noexcept
+    {
+        uri_split ret;
+        ret.scheme = scheme.get(i, uri);
+        ret.authority = authority.get(i, uri);
+        ret.path = path.get(i, uri);
+        ret.query = query.get(i, uri);
+        ret.fragment = fragment.get(i, uri);
+        ret.req_path = req_path.get(i, uri);
+        return ret;
+    }
+
+    static uri_split_columns from_uris(const opt_string_view* uris, size_t n, int components = capi::FURI_URI_ALL)
+    {
+        uri_split_columns ret;
+        ret.m_size = n;
+        auto resize = [&](column& c, int flag) {
+            if (!(components & flag) || !n) return;
+            c.offsets.resize(n);
+            c.lengths.resize(n);
+        };
+        resize(ret.scheme, capi::FURI_URI_SCHEME);
+        resize(ret.authority, capi::FURI_URI_AUTHORITY);
+        resize(ret.path, capi::FURI_URI_PATH);
+        resize(ret.query, capi::FURI_URI_QUERY);
+        resize(ret.fragment, capi::FURI_URI_FRAGMENT);
+        resize(ret.req_path, capi::FURI_URI_REQ_PATH);
+
+        auto cols = ret.c_columns();
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto u = uris[i].c_sv();
+            auto s = capi::furi_split_uri(u);
+            capi::furi_uri_split_columns_set(&cols, i, u, &s);
+        }
+        return ret;
+    }
+
+    static uri_split_columns from_uris(const std::vector<opt_string_view>& uris, int components = capi::FURI_URI_ALL)
+    {
+        return from_uris(uris.data(), uris.size(), components);
+    }
+
+private:
+    std::size_t m_size = 0;
+};
+
 struct authority_split
 {
     opt_string_view userinfo;
     opt_string_view host;
     opt_string_view port;
 
-    static authority_split from_capi(const capi::furi_authority_split& as) noexcept
+    static constexpr authority_split from_capi(const capi::furi_authority_split& as) noexcept
     {
         return {
             opt_string_view(as.userinfo),
@@ -112,9 +418,47 @@ struct authority_split
         };
     }
 
-    static authority_split from_authority(opt_string_view a) noexcept
+    static constexpr authority_split from_authority(opt_string_view a) noexcept
     {
-        return from_capi(capi::furi_split_authority(a.c_sv()));
+        if (!FURI_IS_CONSTANT_EVALUATED()) return from_capi(capi::furi_split_authority(a.c_sv()));
+        return from_authority_native(a);
+    }
+
+    // the same as capi::furi_split_authority without the c api
+    static constexpr authority_split from_authority_native(opt_string_view a) noexcept
+    {
+        authority_split ret;
+
+        size_t f = a.find('@');
+        if (f != opt_string_view::npos)
+        {
+            ret.userinfo = a.substr(0, f);
+            a = a.substr(f + 1);
+        }
+
+        ret.host = a;
+        if (a.empty()) return ret; // empty host
+
+        if (a[0] == '[')
+        {
+            // ipv6
+            f = a.find(']');
+            if (f == opt_string_view::npos) return {}; // invalid uri
+            ret.host = a.substr(0, f + 1);
+            a = a.substr(f + 1);
+            if (a.empty()) return ret; // no port
+            if (a[0] != ':') return {}; // invalid uri
+            ret.port = a.substr(1);
+            return ret;
+        }
+
+        f = a.find(':');
+        if (f != opt_string_view::npos)
+        {
+            ret.host = a.substr(0, f);
+            ret.port = a.substr(f + 1);
+        }
+        return ret;
     }
 
     static opt_string_view get_userinfo_from_authority(opt_string_view a) noexcept
@@ -138,7 +482,7 @@ struct userinfo_split
     opt_string_view username;
     opt_string_view password;
 
-    static userinfo_split from_capi(const capi::furi_userinfo_split& uis) noexcept
+    static constexpr userinfo_split from_capi(const capi::furi_userinfo_split& uis) noexcept
     {
         return {
             opt_string_view(uis.username),
@@ -146,9 +490,18 @@ struct userinfo_split
         };
     }
 
-    static userinfo_split from_userinfo(opt_string_view ui) noexcept
+    static constexpr userinfo_split from_userinfo(opt_string_view ui) noexcept
+    {
+        if (!FURI_IS_CONSTANT_EVALUATED()) return from_capi(capi::furi_split_userinfo(ui.c_sv()));
+        return from_userinfo_native(ui);
+    }
+
+    // the same as capi::furi_split_userinfo without the c api
+    static constexpr userinfo_split from_userinfo_native(opt_string_view ui) noexcept
     {
-        return from_capi(capi::furi_split_userinfo(ui.c_sv()));
+        size_t p = ui.find(':');
+        if (p == opt_string_view::npos) return {ui, {}};
+        return {ui.substr(0, p), ui.substr(p + 1)};
     }
 
     static opt_string_view get_username_from_userinfo(opt_string_view ui) noexcept
@@ -162,41 +515,97 @@ struct userinfo_split
     }
 };
 
+// uri, authority, and userinfo split in a single pass
+struct uri_decomposition
+{
+    uri_split uri;
+    authority_split authority;
+    userinfo_split userinfo;
+
+    static constexpr uri_decomposition from_capi(const capi::furi_uri_decomposition& d) noexcept
+    {
+        return {
+            uri_split::from_capi(d.uri),
+            authority_split::from_capi(d.authority),
+            userinfo_split::from_capi(d.userinfo),
+        };
+    }
+
+    static constexpr uri_decomposition from_uri(opt_string_view u) noexcept
+    {
+        if (!FURI_IS_CONSTANT_EVALUATED()) return from_capi(capi::furi_decompose_uri(u.c_sv()));
+        return from_uri_native(u);
+    }
+
+    // the same as capi::furi_decompose_uri without the c api (but in three passes)
+    static constexpr uri_decomposition from_uri_native(opt_string_view u) noexcept
+    {
+        uri_decomposition ret;
+        ret.uri = uri_split::from_uri_native(u);
+        ret.authority = authority_split::from_authority_native(ret.uri.authority);
+        ret.userinfo = userinfo_split::from_userinfo_native(ret.authority.userinfo);
+        return ret;
+    }
+};
+
+// the same segments as capi::furi_path_iter
 class path_iterator
 {
-    capi::furi_path_iter m_pi;
+    // the current segment or nulls for the end
+    const char* m_begin = nullptr;
+    const char* m_end = nullptr;
+    const char* m_range_end = nullptr;
+
+    constexpr path_iterator(const char* begin, const char* range_end) noexcept
+        : m_begin(begin)
+        , m_end(begin)
+        , m_range_end(range_end)
+    {
+        while (m_end != m_range_end && *m_end != '/') ++m_end;
+    }
 public:
-    path_iterator() : m_pi({nullptr, nullptr, nullptr}) {}
-    explicit path_iterator(const capi::furi_path_iter& pi) : m_pi(pi) {};
+    constexpr path_iterator() noexcept = default;
+    explicit path_iterator(const capi::furi_path_iter& pi) noexcept
+    {
+        if (capi::furi_path_iter_is_done(pi)) return;
+        auto seg = capi::furi_path_iter_get_value(pi);
+        m_begin = seg.begin;
+        m_end = seg.end;
+        m_range_end = pi.range_end;
+    }
 
-    static path_iterator begin_of(opt_string_view path) noexcept
+    static constexpr path_iterator begin_of(opt_string_view path) noexcept
     {
-        return path_iterator(capi::furi_make_path_iter_begin(path.c_sv()));
+        if (path.null()) return {};
+        const char* begin = path.data();
+        if (!path.empty() && path[0] == '/') ++begin;
+        return path_iterator(begin, path.data() + path.size());
     }
 
-    static path_iterator end_of(opt_string_view path) noexcept
+    static constexpr path_iterator end_of(opt_string_view) noexcept
     {
-        return path_iterator(capi::furi_make_path_iter_end(path.c_sv()));
+        return {};
     }
 
-    void operator++() noexcept
+    constexpr void operator++() noexcept
     {
-        capi::furi_path_iter_next(&m_pi);
+        if (m_end == m_range_end) *this = {};
+        else *this = path_iterator(m_end + 1, m_range_end);
     }
 
-    opt_string_view operator*() const noexcept
+    constexpr opt_string_view operator*() const noexcept
     {
-        return opt_string_view(capi::furi_path_iter_get_value(m_pi));
+        return opt_string_view(m_begin, m_end);
     }
 
-    bool operator==(const path_iterator& other) const noexcept
+    constexpr bool operator==(const path_iterator& other) const noexcept
     {
-        return capi::furi_path_iter_equal(m_pi, other.m_pi);
+        return m_begin == other.m_begin;
     }
 
-    bool operator!=(const path_iterator& other) const noexcept
+    constexpr bool operator!=(const path_iterator& other) const noexcept
     {
-        return !capi::furi_path_iter_equal(m_pi, other.m_pi);
+        return m_begin != other.m_begin;
     }
 };
 
@@ -205,51 +614,135 @@ struct path_view : public opt_string_view
 public:
     using opt_string_view::opt_string_view;
     using const_iterator = path_iterator;
-    const_iterator begin() const noexcept { return const_iterator::begin_of(*this); }
-    const_iterator end() const noexcept { return const_iterator::end_of(*this); }
+    constexpr const_iterator begin() const noexcept { return const_iterator::begin_of(*this); }
+    constexpr const_iterator end() const noexcept { return const_iterator::end_of(*this); }
+};
+
+// the same labels as capi::furi_host_label_iter: right to left
+class host_label_iterator
+{
+    // the current label or nulls for the end
+    const char* m_range_begin = nullptr;
+    const char* m_begin = nullptr;
+    const char* m_end = nullptr;
+
+    constexpr host_label_iterator(const char* range_begin, const char* end) noexcept
+        : m_range_begin(range_begin)
+        , m_begin(end)
+        , m_end(end)
+    {
+        while (m_begin != m_range_begin && m_begin[-1] != '.') --m_begin;
+    }
+public:
+    constexpr host_label_iterator() noexcept = default;
+
+    static constexpr host_label_iterator begin_of(opt_string_view host) noexcept
+    {
+        if (host.empty()) return {};
+        const char* end = host.data() + host.size();
+        if (end[-1] == '.' && --end == host.data()) return {};
+        return host_label_iterator(host.data(), end);
+    }
+
+    static constexpr host_label_iterator end_of(opt_string_view) noexcept
+    {
+        return {};
+    }
+
+    constexpr void operator++() noexcept
+    {
+        if (m_begin == m_range_begin) *this = {};
+        else *this = host_label_iterator(m_range_begin, m_begin - 1);
+    }
+
+    constexpr opt_string_view operator*() const noexcept
+    {
+        return opt_string_view(m_begin, m_end);
+    }
+
+    constexpr bool operator==(const host_label_iterator& other) const noexcept
+    {
+        return m_end == other.m_end;
+    }
+
+    constexpr bool operator!=(const host_label_iterator& other) const noexcept
+    {
+        return m_end != other.m_end;
+    }
+};
+
+struct host_labels_view : public opt_string_view
+{
+public:
+    using opt_string_view::opt_string_view;
+    using const_iterator = host_label_iterator;
+    constexpr const_iterator begin() const noexcept { return const_iterator::begin_of(*this); }
+    constexpr const_iterator end() const noexcept { return const_iterator::end_of(*this); }
 };
 
 using query_item = std::pair<opt_string_view, opt_string_view>;
 
+// the same items as capi::furi_query_iter
 class query_iterator
 {
-    capi::furi_query_iter m_qi;
+    // the current item or nulls for the end
+    const char* m_begin = nullptr;
+    const char* m_end = nullptr;
+    const char* m_kv_sep = nullptr; // the last '=' in the item or null
+    const char* m_range_end = nullptr;
+
+    constexpr query_iterator(const char* begin, const char* range_end) noexcept
+        : m_begin(begin)
+        , m_end(begin)
+        , m_range_end(range_end)
+    {
+        for (; m_end != m_range_end && *m_end != FURI_QUERY_ITEM_SEP; ++m_end)
+        {
+            if (*m_end == FURI_QUERY_KV_SEP) m_kv_sep = m_end;
+        }
+    }
 public:
-    query_iterator() : m_qi({nullptr, nullptr, nullptr, nullptr}) {}
-    explicit query_iterator(const capi::furi_query_iter& pi) : m_qi(pi) {};
+    constexpr query_iterator() noexcept = default;
+    explicit query_iterator(const capi::furi_query_iter& qi) noexcept
+    {
+        if (capi::furi_query_iter_is_done(qi)) return;
+        m_begin = qi.begin + 1;
+        m_end = qi.p;
+        m_kv_sep = qi.kv_sep_pos;
+        m_range_end = qi.range_end;
+    }
 
-    static query_iterator begin_of(opt_string_view path) noexcept
+    static constexpr query_iterator begin_of(opt_string_view query) noexcept
     {
-        return query_iterator(capi::furi_make_query_iter_begin(path.c_sv()));
+        if (query.empty()) return {};
+        return query_iterator(query.data(), query.data() + query.size());
     }
 
-    static query_iterator end_of(opt_string_view path) noexcept
+    static constexpr query_iterator end_of(opt_string_view) noexcept
     {
-        return query_iterator(capi::furi_make_query_iter_end(path.c_sv()));
+        return {};
     }
 
-    void operator++() noexcept
+    constexpr void operator++() noexcept
     {
-        capi::furi_query_iter_next(&m_qi);
+        if (m_end == m_range_end) *this = {};
+        else *this = query_iterator(m_end + 1, m_range_end);
     }
 
-    query_item operator*() const noexcept
+    constexpr query_item operator*() const noexcept
     {
-        auto c = furi_query_iter_get_value(m_qi);
-        return {
-            opt_string_view(c.key),
-            opt_string_view(c.value),
-        };
+        if (!m_kv_sep) return {opt_string_view(m_begin, m_end), opt_string_view()};
+        return {opt_string_view(m_begin, m_kv_sep), opt_string_view(m_kv_sep + 1, m_end)};
     }
 
-    bool operator==(const query_iterator& other) const noexcept
+    constexpr bool operator==(const query_iterator& other) const noexcept
     {
-        return capi::furi_query_iter_equal(m_qi, other.m_qi);
+        return m_begin == other.m_begin;
     }
 
-    bool operator!=(const query_iterator& other) const noexcept
+    constexpr bool operator!=(const query_iterator& other) const noexcept
     {
-        return !capi::furi_query_iter_equal(m_qi, other.m_qi);
+        return m_begin != other.m_begin;
     }
 };
 
@@ -258,8 +751,455 @@ struct query_view : public opt_string_view
 public:
     using opt_string_view::opt_string_view;
     using const_iterator = query_iterator;
-    const_iterator begin() const noexcept { return const_iterator::begin_of(*this); }
-    const_iterator end() const noexcept { return const_iterator::end_of(*this); }
+    constexpr const_iterator begin() const noexcept { return const_iterator::begin_of(*this); }
+    constexpr const_iterator end() const noexcept { return const_iterator::end_of(*this); }
 };
 
+// read-only flat map-like index of the items of a query
+// iteration is in query order. find, find_all, and count are hash lookups
+// small queries are indexed in inline storage, bigger ones allocate
+// the index points into its own storage, so it can't be copied
+class query_index
+{
+public:
+    using key_type = opt_string_view;
+    using mapped_type = opt_string_view;
+    using value_type = query_item;
+    using size_type = size_t;
+
+    class const_iterator
+    {
+        const capi::furi_query_index_item* m_item = nullptr;
+    public:
+        const_iterator() noexcept = default;
+        explicit const_iterator(const capi::furi_query_index_item* item) noexcept : m_item(item) {}
+
+        void operator++() noexcept { ++m_item; }
+        value_type operator*() const noexcept { return {opt_string_view(m_item->key), opt_string_view(m_item->value)}; }
+        bool operator==(const const_iterator& other) const noexcept { return m_item == other.m_item; }
+        bool operator!=(const const_iterator& other) const noexcept { return m_item != other.m_item; }
+    };
+
+    // iterates over the items with the same key
+    class key_iterator
+    {
+        const capi::furi_query_index* m_index = nullptr;
+        const capi::furi_query_index_item* m_item = nullptr;
+    public:
+        key_iterator() noexcept = default;
+        key_iterator(const capi::furi_query_index* index, const capi::furi_query_index_item* item) noexcept
+            : m_index(index), m_item(item) {}
+
+        void operator++() noexcept { m_item = capi::furi_query_index_find_next(m_index, m_item); }
+        value_type operator*() const noexcept { return {opt_string_view(m_item->key), opt_string_view(m_item->value)}; }
+        bool operator==(const key_iterator& other) const noexcept { return m_item == other.m_item; }
+        bool operator!=(const key_iterator& other) const noexcept { return m_item != other.m_item; }
+    };
+
+    struct key_range
+    {
+        key_iterator b, e;
+        key_iterator begin() const noexcept { return b; }
+        key_iterator end() const noexcept { return e; }
+        bool empty() const noexcept { return b == e; }
+    };
+
+    explicit query_index(opt_string_view query)
+    {
+        m_index = capi::furi_make_query_index_from_storage(&m_storage);
+        capi::furi_query_index_build(&m_index, query.c_sv());
+        if (!m_index.truncated) return;
+
+        // more items than the inline storage can hold
+        uint32_t capacity = 1;
+        for (char c : query) capacity += c == FURI_QUERY_ITEM_SEP;
+        uint32_t slot_count = capi::furi_query_index_slot_count(capacity);
+        m_items.resize(capacity);
+        m_slots.resize(slot_count);
+        m_index = capi::furi_make_query_index(m_items.data(), capacity, m_slots.data(), slot_count);
+        capi::furi_query_index_build(&m_index, query.c_sv());
+    }
+
+    query_index(const query_index&) = delete;
+    query_index& operator=(const query_index&) = delete;
+
+    [[nodiscard]] size_type size() const noexcept { return m_index.size; }
+    [[nodiscard]] bool empty() const noexcept { return m_index.size == 0; }
+
+    const_iterator begin() const noexcept { return const_iterator(m_index.items); }
+    const_iterator end() const noexcept { return const_iterator(m_index.items + m_index.size); }
+
+    // first item with key or end()
+    [[nodiscard]] const_iterator find(opt_string_view key) const noexcept
+    {
+        auto item = capi::furi_query_index_find(&m_index, key.c_sv());
+        return item ? const_iterator(item) : end();
+    }
+
+    // all items with key in query order
+    [[nodiscard]] key_range find_all(opt_string_view key) const noexcept
+    {
+        return {key_iterator(&m_index, capi::furi_query_index_find(&m_index, key.c_sv())), key_iterator()};
+    }
+
+    [[nodiscard]] size_type count(opt_string_view key) const noexcept
+    {
+        return capi::furi_query_index_count(&m_index, key.c_sv());
+    }
+
+    [[nodiscard]] bool contains(opt_string_view key) const noexcept
+    {
+        return !!capi::furi_query_index_find(&m_index, key.c_sv());
+    }
+
+    // value of the first item with key
+    // null if there is no such item or if the item has no value
+    [[nodiscard]] opt_string_view value(opt_string_view key) const noexcept
+    {
+        auto item = capi::furi_query_index_find(&m_index, key.c_sv());
+        return item ? opt_string_view(item->value) : opt_string_view();
+    }
+
+private:
+    capi::furi_query_index_storage m_storage;
+    std::vector<capi::furi_query_index_item> m_items;
+    std::vector<capi::furi_query_index_slot> m_slots;
+    capi::furi_query_index m_index;
+};
+
+namespace impl
+{
+// temporaries which own their chars (like std::string) would dangle in a view
+template <typename T>
+inline constexpr bool is_dangling_key_v = !std::is_lvalue_reference_v<T>
+    && !std::is_trivially_destructible_v<std::remove_cv_t<std::remove_reference_t<T>>>;
+}
+
+// a fixed set of query keys to extract in a single scan
+// can be constexpr: constexpr furi::query_keys keys("utm_source", "utm_medium", "id");
+// it doesn't copy the keys, so they must outlive it (temporary strings are rejected)
+template <size_t N>
+class query_keys
+{
+    static_assert(N > 0 && N <= FURI_QUERY_EXTRACT_MAX_KEYS);
+    capi::furi_sv m_keys[N] = {};
+    capi::furi_query_key_filter m_filter = {};
+public:
+    template <typename... Keys, std::enable_if_t<!(impl::is_dangling_key_v<Keys> || ...), int> = 0>
+    constexpr explicit query_keys(Keys&&... keys) noexcept
+    {
+        static_assert(sizeof...(Keys) == N);
+        // the same as capi::furi_make_query_key_filter, but constexpr
+        std::string_view svs[] = {std::string_view(keys)...};
+        for (size_t i = 0; i < N; ++i)
+        {
+            m_keys[i] = {svs[i].data(), svs[i].data() + svs[i].size()};
+            auto len = svs[i].size();
+            m_filter.lengths |= uint64_t(1) << (len < 63 ? len : 63);
+            if (len)
+            {
+                auto c = (unsigned char)svs[i][0];
+                m_filter.first_chars[c >> 6] |= uint64_t(1) << (c & 63);
+            }
+        }
+    }
+
+    static constexpr size_t size() noexcept { return N; }
+
+    // the first item with each key (with a null key if there is none)
+    std::array<query_item, N> extract(opt_string_view query) const noexcept
+    {
+        capi::furi_query_iter_value out[N];
+        capi::furi_query_extract(query.c_sv(), m_keys, uint32_t(N), &m_filter, out);
+        std::array<query_item, N> ret;
+        for (size_t i = 0; i < N; ++i) ret[i] = {opt_string_view(out[i].key), opt_string_view(out[i].value)};
+        return ret;
+    }
+};
+
+template <typename... Keys>
+query_keys(Keys&&...) -> query_keys<sizeof...(Keys)>;
+
+// percent decoding
+
+[[nodiscard]] inline bool needs_pct_decoding(opt_string_view str, bool plus_as_space = false) noexcept
+{
+    return capi::furi_sv_needs_pct_decoding(str.c_sv(), plus_as_space);
+}
+
+// buf must have room for at least str.size() chars
+// returns str itself if there's nothing to decode
+[[nodiscard]] inline opt_string_view pct_decode(opt_string_view str, char* buf, bool plus_as_space = false) noexcept
+{
+    return opt_string_view(capi::furi_pct_decode_if_needed(str.c_sv(), buf, plus_as_space));
+}
+
+[[nodiscard]] inline std::string pct_decode_to_string(opt_string_view str, bool plus_as_space = false)
+{
+    std::string ret(str.size(), '\0');
+    auto d = capi::furi_pct_decode(str.c_sv(), ret.data(), plus_as_space);
+    ret.resize(capi::furi_sv_length(d));
+    return ret;
+}
+
+// strict validation
+// component is 0 if the uri is valid, otherwise the capi::furi_uri_component of the first violation
+struct uri_violation
+{
+    int component = 0;
+    size_t offset = 0;
+
+    constexpr explicit operator bool() const noexcept { return component != 0; }
+
+    static constexpr uri_violation from_capi(const capi::furi_uri_violation& v) noexcept
+    {
+        return {v.component, v.offset};
+    }
+};
+
+namespace impl
+{
+constexpr bool char_is(char c, capi::furi_char_class cc) noexcept
+{
+    return (capi::furi_char_class_table[(unsigned char)c] >> cc) & 1;
+}
+
+constexpr bool is_hex_digit(char c) noexcept
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// the same as capi::furi_validate_component without the c api
+constexpr bool validate_component(uri_violation& v, opt_string_view uri, opt_string_view comp,
+    int component, capi::furi_char_class cc, bool pct) noexcept
+{
+    for (size_t i = 0; i < comp.size(); )
+    {
+        if (char_is(comp[i], cc))
+        {
+            ++i;
+        }
+        else if (pct && comp[i] == '%' && comp.size() - i >= 3 && is_hex_digit(comp[i + 1]) && is_hex_digit(comp[i + 2]))
+        {
+            i += 3;
+        }
+        else
+        {
+            v.component = component;
+            v.offset = size_t(comp.data() + i - uri.data());
+            return false;
+        }
+    }
+    return true;
+}
+
+// the same as capi::furi_validate_split without the c api
+constexpr uri_violation validate_split(const uri_split& s, const authority_split& a, opt_string_view uri) noexcept
+{
+    uri_violation ret;
+
+    if (s.scheme)
+    {
+        if (s.scheme.empty() || !char_is(s.scheme[0], capi::FURI_CC_ALPHA))
+        {
+            return {capi::FURI_URI_SCHEME, size_t(s.scheme.data() - uri.data())};
+        }
+        if (!validate_component(ret, uri, s.scheme, capi::FURI_URI_SCHEME, capi::FURI_CC_SCHEME, false)) return ret;
+    }
+
+    if (s.authority)
+    {
+        // furi_split_authority failed
+        if (!a.host) return {capi::FURI_URI_HOST, size_t(s.authority.data() - uri.data())};
+
+        if (!validate_component(ret, uri, a.userinfo, capi::FURI_URI_USERINFO, capi::FURI_CC_USERINFO, true)) return ret;
+
+        if (!a.host.empty() && a.host[0] == '[')
+        {
+            auto inner = a.host.substr(1, a.host.size() - 2);
+            if (!validate_component(ret, uri, inner, capi::FURI_URI_HOST, capi::FURI_CC_USERINFO, false)) return ret;
+        }
+        else if (!validate_component(ret, uri, a.host, capi::FURI_URI_HOST, capi::FURI_CC_REG_NAME, true)) return ret;
+
+        if (!validate_component(ret, uri, a.port, capi::FURI_URI_PORT, capi::FURI_CC_PORT, false)) return ret;
+    }
+
+    if (!validate_component(ret, uri, s.path, capi::FURI_URI_PATH, capi::FURI_CC_PATH, true)) return ret;
+    if (!validate_component(ret, uri, s.query, capi::FURI_URI_QUERY, capi::FURI_CC_QUERY, true)) return ret;
+    validate_component(ret, uri, s.fragment, capi::FURI_URI_FRAGMENT, capi::FURI_CC_QUERY, true);
+    return ret;
+}
+
+}
+
+// same as uri_split::from_uri, also fills violation
+[[nodiscard]] constexpr uri_split split_uri_strict(opt_string_view uri, uri_violation& violation) noexcept
+{
+    if (!FURI_IS_CONSTANT_EVALUATED())
+    {
+        capi::furi_uri_violation v = {};
+        auto split = capi::furi_split_uri_strict(uri.c_sv(), &v);
+        violation = uri_violation::from_capi(v);
+        return uri_split::from_capi(split);
+    }
+    auto d = uri_decomposition::from_uri_native(uri);
+    violation = impl::validate_split(d.uri, d.authority, uri);
+    return d.uri;
+}
+
+[[nodiscard]] constexpr uri_violation validate_uri(opt_string_view uri) noexcept
+{
+    uri_violation ret;
+    [[maybe_unused]] auto split = split_uri_strict(uri, ret);
+    return ret;
+}
+
+[[nodiscard]] constexpr bool is_valid_uri(opt_string_view uri) noexcept
+{
+    return !validate_uri(uri);
+}
+
+// a uri literal which is split and validated at compile time:
+// constexpr auto u = "https://example.com/a?b=c"_uri; // u.parts.uri.path == "/a"
+// an invalid literal is a compile error in a constant expression and throws std::invalid_argument otherwise
+struct uri_literal
+{
+    opt_string_view str;
+    uri_decomposition parts;
+};
+
+namespace literals
+{
+constexpr uri_literal operator""_uri(const char* str, size_t len)
+{
+    opt_string_view u(str, str + len);
+    auto d = uri_decomposition::from_uri_native(u);
+    if (impl::validate_split(d.uri, d.authority, u)) throw std::invalid_argument("invalid uri literal");
+    return {u, d};
+}
+}
+
+// scheme classification (see capi::furi_classify_scheme)
+using scheme_id = capi::furi_scheme_id;
+
+namespace impl
+{
+constexpr uint32_t scheme_slot(uint32_t length, char first, char last) noexcept
+{
+    uint32_t key = length | uint32_t((unsigned char)(first | 0x20)) << 8 | uint32_t((unsigned char)(last | 0x20)) << 16;
+    return uint32_t(key * FURI_SCHEME_HASH_MUL) >> (32 - FURI_SCHEME_HASH_BITS);
+}
+
+// the slot table generated from the scheme table
+// a collision results in an empty table
+constexpr std::array<uint8_t, 1 << FURI_SCHEME_HASH_BITS> make_scheme_slots() noexcept
+{
+    std::array<uint8_t, 1 << FURI_SCHEME_HASH_BITS> ret = {};
+    for (int id = capi::FURI_SCHEME_OTHER + 1; id < capi::FURI_SCHEME_COUNT; ++id)
+    {
+        const auto& info = capi::furi_scheme_infos[id];
+        auto slot = scheme_slot(info.length, info.name[0], info.name[info.length - 1]);
+        if (ret[slot] || info.length > FURI_SCHEME_MAX_LENGTH) return {};
+        ret[slot] = uint8_t(id);
+    }
+    return ret;
+}
+
+constexpr bool scheme_slots_match() noexcept
+{
+    auto slots = make_scheme_slots();
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+        if (slots[i] != capi::furi_scheme_slots[i]) return false;
+    }
+    return true;
+}
+
+static_assert(scheme_slots_match(), "capi::furi_scheme_slots doesn't match the schemes: regenerate it with make_scheme_slots");
+}
+
+// the same as capi::furi_classify_scheme without the c api
+[[nodiscard]] constexpr scheme_id classify_scheme(opt_string_view scheme) noexcept
+{
+    if (!scheme) return capi::FURI_SCHEME_NONE;
+    if (scheme.empty() || scheme.size() > FURI_SCHEME_MAX_LENGTH) return capi::FURI_SCHEME_OTHER;
+    auto id = capi::furi_scheme_slots[impl::scheme_slot(uint32_t(scheme.size()), scheme.front(), scheme.back())];
+    const auto& info = capi::furi_scheme_infos[id];
+    if (info.length != scheme.size()) return capi::FURI_SCHEME_OTHER;
+    for (size_t i = 0; i < scheme.size(); ++i)
+    {
+        char c = scheme[i];
+        if (c >= 'A' && c <= 'Z') c = char(c | 0x20);
+        if (c != info.name[i]) return capi::FURI_SCHEME_OTHER;
+    }
+    return scheme_id(id);
+}
+
+// 0 for schemes with no default port (including unknown ones)
+[[nodiscard]] constexpr uint16_t default_port(scheme_id id) noexcept
+{
+    return capi::furi_scheme_infos[id].default_port;
+}
+
+[[nodiscard]] constexpr opt_string_view scheme_name(scheme_id id) noexcept
+{
+    const auto& info = capi::furi_scheme_infos[id];
+    return opt_string_view(info.name, info.name + info.length);
+}
+
+// host and port decoding
+struct host_address
+{
+    capi::furi_host_kind kind = capi::FURI_HOST_INVALID;
+    uint32_t ipv4 = 0; // host byte order
+    std::array<uint8_t, 16> ipv6 = {}; // network byte order
+
+    explicit operator bool() const noexcept { return kind != capi::FURI_HOST_INVALID; }
+
+    static host_address from_capi(const capi::furi_host_address& ha) noexcept
+    {
+        host_address ret;
+        ret.kind = ha.kind;
+        ret.ipv4 = ha.ipv4;
+        std::copy(std::begin(ha.ipv6), std::end(ha.ipv6), ret.ipv6.begin());
+        return ret;
+    }
+
+    static host_address from_host(opt_string_view host) noexcept
+    {
+        return from_capi(capi::furi_decode_host(host.c_sv()));
+    }
+};
+
+[[nodiscard]] inline std::optional<uint32_t> parse_ipv4(opt_string_view str) noexcept
+{
+    uint32_t ret;
+    if (!capi::furi_parse_ipv4(str.c_sv(), &ret)) return std::nullopt;
+    return ret;
+}
+
+[[nodiscard]] inline std::optional<std::array<uint8_t, 16>> parse_ipv6(opt_string_view str) noexcept
+{
+    std::array<uint8_t, 16> ret;
+    if (!capi::furi_parse_ipv6(str.c_sv(), ret.data())) return std::nullopt;
+    return ret;
+}
+
+[[nodiscard]] inline std::optional<uint16_t> parse_port(opt_string_view str) noexcept
+{
+    uint16_t ret;
+    if (!capi::furi_parse_port(str.c_sv(), &ret)) return std::nullopt;
+    return ret;
+}
+
+}
+
+// the same as the hash of std::string_view, so null and empty views have the same hash
+namespace std
+{
+template <>
+struct hash<furi::opt_string_view>
+{
+    size_t operator()(furi::opt_string_view s) const noexcept { return hash<string_view>{}(s); }
+};
 }
@@ -0,0 +1,193 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// http/1.x request line
+// METHOD SP request-target SP HTTP-version [CR] [LF]
+
+typedef enum furi_http_method
+{
+    FURI_HTTP_OTHER, // valid token, but not one of the standard methods
+    FURI_HTTP_GET,
+    FURI_HTTP_HEAD,
+    FURI_HTTP_POST,
+    FURI_HTTP_PUT,
+    FURI_HTTP_DELETE,
+    FURI_HTTP_CONNECT,
+    FURI_HTTP_OPTIONS,
+    FURI_HTTP_TRACE,
+    FURI_HTTP_PATCH
+} furi_http_method;
+
+typedef enum furi_http_target_form
+{
+    FURI_HTTP_TARGET_INVALID, // the request line is invalid
+    FURI_HTTP_TARGET_ORIGIN, // /path?query
+    FURI_HTTP_TARGET_ABSOLUTE, // scheme://authority/path?query
+    FURI_HTTP_TARGET_AUTHORITY, // host:port (CONNECT only)
+    FURI_HTTP_TARGET_ASTERISK // * (OPTIONS only)
+} furi_http_target_form;
+
+typedef struct furi_http_request_line
+{
+    furi_sv method;
+    furi_http_method method_id;
+
+    furi_sv target;
+    furi_http_target_form target_form;
+
+    // target split with furi_split_uri
+    // for authority-form targets only authority is set: path and req_path are null,
+    // unlike the other forms (where req_path is at least "/" or "*")
+    furi_uri_split split;
+
+    furi_sv version; // "HTTP/x.y"
+    int version_major;
+    int version_minor;
+} furi_http_request_line;
+
+FURI_INLINE furi_http_method furi_http_method_from_sv(furi_sv m)
+{
+#define FURI_HTTP_METHOD_CASE(str, id) if (memcmp(m.begin, str, sizeof(str) - 1) == 0) return id
+    switch (furi_sv_length(m))
+    {
+    case 3:
+        FURI_HTTP_METHOD_CASE("GET", FURI_HTTP_GET);
+        FURI_HTTP_METHOD_CASE("PUT", FURI_HTTP_PUT);
+        break;
+    case 4:
+        FURI_HTTP_METHOD_CASE("POST", FURI_HTTP_POST);
+        FURI_HTTP_METHOD_CASE("HEAD", FURI_HTTP_HEAD);
+        break;
+    case 5:
+        FURI_HTTP_METHOD_CASE("PATCH", FURI_HTTP_PATCH);
+        FURI_HTTP_METHOD_CASE("TRACE", FURI_HTTP_TRACE);
+        break;
+    case 6:
+        FURI_HTTP_METHOD_CASE("DELETE", FURI_HTTP_DELETE);
+        break;
+    case 7:
+        FURI_HTTP_METHOD_CASE("OPTIONS", FURI_HTTP_OPTIONS);
+        FURI_HTTP_METHOD_CASE("CONNECT", FURI_HTTP_CONNECT);
+        break;
+    default:
+        break;
+    }
+#undef FURI_HTTP_METHOD_CASE
+    return FURI_HTTP_OTHER;
+}
+
+// fast path for origin-form targets (which begin with '/')
+// same result as furi_split_uri, but there is no scheme to search for
+FURI_INLINE furi_uri_split furi_split_origin_form(furi_sv target)
+{
+    assert(!furi_sv_is_empty(target) && target.begin[0] == '/');
+    furi_uri_split ret = FURI_EMPTY_VAL;
+    furi_split_uri_tail(&ret, target, target.begin);
+    return ret;
+}
+
+FURI_INLINE bool furi_http_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// tchar of rfc 9110: ALPHA DIGIT ! # $ % & ' * + - . ^ _ ` | ~
+FURI_INLINE bool furi_http_is_tchar(char c)
+{
+    if (furi_char_is(c, FURI_CC_UNRESERVED)) return true;
+    switch (c)
+    {
+    case '!': case '#': case '$': case '%': case '&': case '\'':
+    case '*': case '+': case '^': case '`': case '|':
+        return true;
+    default:
+        return false;
+    }
+}
+
+FURI_INLINE bool furi_http_is_token(furi_sv s)
+{
+    if (furi_sv_is_empty(s)) return false;
+    for (const char* p = s.begin; p != s.end; ++p)
+    {
+        if (!furi_http_is_tchar(*p)) return false;
+    }
+    return true;
+}
+
+FURI_INLINE furi_http_request_line furi_parse_http_request_line(furi_sv line)
+{
+    furi_http_request_line ret = FURI_EMPTY_VAL;
+
+    // strip line ending
+    if (!furi_sv_is_empty(line) && line.end[-1] == '\n') --line.end;
+    if (!furi_sv_is_empty(line) && line.end[-1] == '\r') --line.end;
+
+    const char* sp1 = furi_sv_find_first(line, ' ');
+    const char* sp2 = furi_sv_find_last(line, ' ');
+    if (!sp1 || sp1 == sp2 || sp1 == line.begin) return ret; // invalid
+
+    furi_sv method = furi_make_sv(line.begin, sp1);
+    furi_sv target = furi_make_sv(sp1 + 1, sp2);
+    furi_sv version = furi_make_sv(sp2 + 1, line.end);
+
+    if (furi_sv_is_empty(target) || furi_sv_find_first(target, ' ')) return ret;
+
+    // HTTP/d.d
+    if (furi_sv_length(version) != 8
+        || !furi_sv_starts_with(version, "HTTP/")
+        || !furi_http_is_digit(version.begin[5])
+        || version.begin[6] != '.'
+        || !furi_http_is_digit(version.begin[7])
+    ) return ret;
+
+    furi_http_method method_id = furi_http_method_from_sv(method);
+    if (method_id == FURI_HTTP_OTHER && !furi_http_is_token(method)) return ret; // standard methods are tokens
+
+    ret.method = method;
+    ret.method_id = method_id;
+    ret.target = target;
+    ret.version = version;
+    ret.version_major = version.begin[5] - '0';
+    ret.version_minor = version.begin[7] - '0';
+
+    if (target.begin[0] == '/')
+    {
+        ret.target_form = FURI_HTTP_TARGET_ORIGIN;
+        ret.split = furi_split_origin_form(target);
+    }
+    else if (ret.method_id == FURI_HTTP_CONNECT)
+    {
+        ret.target_form = FURI_HTTP_TARGET_AUTHORITY;
+        ret.split.authority = target;
+    }
+    else if (ret.method_id == FURI_HTTP_OPTIONS && furi_sv_length(target) == 1 && target.begin[0] == '*')
+    {
+        ret.target_form = FURI_HTTP_TARGET_ASTERISK;
+        ret.split = furi_split_uri(target);
+    }
+    else
+    {
+        ret.split = furi_split_uri(target);
+        if (furi_sv_is_null(ret.split.scheme)) return FURI_EMPTY_T(furi_http_request_line); // invalid
+        ret.target_form = FURI_HTTP_TARGET_ABSOLUTE;
+    }
+
+    return ret;
+}
+
+#if defined(__cplusplus)
+}
+#endif
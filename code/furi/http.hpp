@@ -0,0 +1,44 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "http.h"
+
+namespace furi
+{
+
+struct http_request_line
+{
+    opt_string_view method;
+    capi::furi_http_method method_id = capi::FURI_HTTP_OTHER;
+    opt_string_view target;
+    capi::furi_http_target_form target_form = capi::FURI_HTTP_TARGET_INVALID;
+    uri_split split; // only authority is set for authority-form targets
+    opt_string_view version;
+    int version_major = 0;
+    int version_minor = 0;
+
+    explicit operator bool() const noexcept { return target_form != capi::FURI_HTTP_TARGET_INVALID; }
+
+    static http_request_line from_capi(const capi::furi_http_request_line& rl) noexcept
+    {
+        http_request_line ret;
+        ret.method = opt_string_view(rl.method);
+        ret.method_id = rl.method_id;
+        ret.target = opt_string_view(rl.target);
+        ret.target_form = rl.target_form;
+        ret.split = uri_split::from_capi(rl.split);
+        ret.version = opt_string_view(rl.version);
+        ret.version_major = rl.version_major;
+        ret.version_minor = rl.version_minor;
+        return ret;
+    }
+
+    static http_request_line from_line(opt_string_view line) noexcept
+    {
+        return from_capi(capi::furi_parse_http_request_line(line.c_sv()));
+    }
+};
+
+}
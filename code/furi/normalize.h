@@ -0,0 +1,253 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// dot segment removal (RFC 3986 5.2.4)
+// works in place and returns the new end of the path
+FURI_INLINE char* furi_remove_dot_segments(char* begin, char* end)
+{
+    char* r = begin; // input
+    char* w = begin; // output (never after r)
+    while (r != end)
+    {
+        size_t left = end - r;
+
+        // A: remove prefix "../" or "./"
+        if (left >= 3 && r[0] == '.' && r[1] == '.' && r[2] == '/')
+        {
+            r += 3;
+            continue;
+        }
+        if (left >= 2 && r[0] == '.' && r[1] == '/')
+        {
+            r += 2;
+            continue;
+        }
+
+        // B: replace prefix "/./" or "/." (complete segment) with "/"
+        if (left >= 3 && r[0] == '/' && r[1] == '.' && r[2] == '/')
+        {
+            r += 2;
+            continue;
+        }
+        if (left == 2 && r[0] == '/' && r[1] == '.')
+        {
+            r[1] = '/'; // r is ahead of w, so we can change the input
+            r += 1;
+            continue;
+        }
+
+        // C: replace prefix "/../" or "/.." (complete segment) with "/" and remove the last output segment
+        bool up = false;
+        if (left >= 4 && r[0] == '/' && r[1] == '.' && r[2] == '.' && r[3] == '/')
+        {
+            r += 3;
+            up = true;
+        }
+        else if (left == 3 && r[0] == '/' && r[1] == '.' && r[2] == '.')
+        {
+            r[2] = '/';
+            r += 2;
+            up = true;
+        }
+        if (up)
+        {
+            while (w != begin && *--w != '/');
+            continue;
+        }
+
+        // D: remove "." or ".."
+        if ((left == 1 && r[0] == '.') || (left == 2 && r[0] == '.' && r[1] == '.'))
+        {
+            r = end;
+            continue;
+        }
+
+        // E: move the first segment (with its initial "/" if any) to the output
+        char* seg_end = r + 1;
+        while (seg_end != end && *seg_end != '/') ++seg_end;
+        size_t seg_len = seg_end - r;
+        if (w != r) memmove(w, r, seg_len);
+        w += seg_len;
+        r = seg_end;
+    }
+    return w;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// normalization (RFC 3986 6.2.2)
+//  * scheme and host are lowercased
+//  * percent escapes of unreserved characters are decoded, the rest get uppercase hex digits
+//  * dot segments are removed from absolute paths (and all paths of uris with a scheme)
+//  * default ports and empty ports are removed
+//  * an empty path with an authority becomes "/"
+
+// normalizes percent escapes of in and writes it to out
+// optionally lowercases everything else
+// returns the end of the output
+FURI_INLINE char* furi_normalize_pct(furi_sv in, char* out, bool lower)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    const char* p = in.begin;
+    while (p != in.end)
+    {
+        if (!lower)
+        {
+            // copy runs with no escapes in bulk
+            const char* f = furi_sv_find_first(furi_make_sv(p, in.end), '%');
+            size_t run = (f ? f : in.end) - p;
+            memcpy(out, p, run);
+            out += run;
+            p += run;
+            if (!f) break;
+        }
+
+        char c = *p;
+        if (c == '%' && in.end - p >= 3)
+        {
+            int hi = furi_hex_digit_value(p[1]);
+            int lo = furi_hex_digit_value(p[2]);
+            if (hi >= 0 && lo >= 0)
+            {
+                char d = (char)(hi * 16 + lo);
+                if (furi_char_is(d, FURI_CC_UNRESERVED))
+                {
+                    *out++ = lower ? furi_ascii_tolower(d) : d;
+                }
+                else
+                {
+                    *out++ = '%';
+                    *out++ = hex[hi];
+                    *out++ = hex[lo];
+                }
+                p += 3;
+                continue;
+            }
+        }
+
+        *out++ = lower ? furi_ascii_tolower(c) : c;
+        ++p;
+    }
+    return out;
+}
+
+// returns the default port of a scheme or 0 if it's not known (see furi_classify_scheme)
+FURI_INLINE unsigned furi_normalize_default_port(furi_sv scheme)
+{
+    return furi_scheme_default_port(furi_classify_scheme(scheme));
+}
+
+FURI_INLINE bool furi_normalize_is_default_port(furi_sv port, unsigned default_port)
+{
+    if (!default_port) return false;
+    unsigned value = 0;
+    for (const char* p = port.begin; p != port.end; ++p)
+    {
+        if (*p < '0' || *p > '9') return false;
+        value = value * 10 + (*p - '0');
+        if (value > 65535) return false;
+    }
+    return value == default_port;
+}
+
+// out must have room for at least this many chars
+FURI_INLINE size_t furi_normalize_uri_max_length(size_t uri_length)
+{
+    return uri_length + 1; // an empty path with authority becomes "/"
+}
+
+// writes the normalized uri to out and returns its split
+// the normalized uri is [out, req_path.end)
+FURI_INLINE furi_uri_split furi_normalize_uri(furi_sv uri, char* out)
+{
+    furi_uri_split ret = FURI_EMPTY_VAL;
+    if (furi_sv_is_null(uri)) return ret;
+
+    furi_uri_decomposition d = furi_decompose_uri(uri);
+    char* o = out;
+
+    if (d.uri.scheme.begin)
+    {
+        o = furi_normalize_pct(d.uri.scheme, o, true);
+        ret.scheme = furi_make_sv(out, o);
+        *o++ = ':';
+    }
+
+    if (d.uri.authority.begin)
+    {
+        *o++ = '/';
+        *o++ = '/';
+        char* abegin = o;
+        if (furi_sv_is_null(d.authority.host))
+        {
+            // invalid authority: only normalize escapes
+            o = furi_normalize_pct(d.uri.authority, o, false);
+        }
+        else
+        {
+            if (d.authority.userinfo.begin)
+            {
+                o = furi_normalize_pct(d.authority.userinfo, o, false);
+                *o++ = '@';
+            }
+            o = furi_normalize_pct(d.authority.host, o, true);
+            if (!furi_sv_is_empty(d.authority.port)
+                && !furi_normalize_is_default_port(d.authority.port, furi_normalize_default_port(ret.scheme)))
+            {
+                *o++ = ':';
+                memcpy(o, d.authority.port.begin, furi_sv_length(d.authority.port));
+                o += furi_sv_length(d.authority.port);
+            }
+        }
+        ret.authority = furi_make_sv(abegin, o);
+    }
+
+    char* pbegin = o;
+    if (d.uri.path.begin)
+    {
+        o = furi_normalize_pct(d.uri.path, o, false);
+        if (d.uri.scheme.begin || (o != pbegin && *pbegin == '/'))
+        {
+            o = furi_remove_dot_segments(pbegin, o);
+        }
+    }
+    if (d.uri.authority.begin && o == pbegin)
+    {
+        *o++ = '/';
+    }
+    ret.path = furi_make_sv(pbegin, o);
+
+    if (d.uri.query.begin)
+    {
+        *o++ = '?';
+        char* qbegin = o;
+        o = furi_normalize_pct(d.uri.query, o, false);
+        ret.query = furi_make_sv(qbegin, o);
+    }
+
+    if (d.uri.fragment.begin)
+    {
+        *o++ = '#';
+        char* fbegin = o;
+        o = furi_normalize_pct(d.uri.fragment, o, false);
+        ret.fragment = furi_make_sv(fbegin, o);
+    }
+
+    ret.req_path = furi_make_sv(pbegin, o);
+    return ret;
+}
+
+#if defined(__cplusplus)
+}
+#endif
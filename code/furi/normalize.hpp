@@ -0,0 +1,30 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "normalize.h"
+
+namespace furi
+{
+
+// appends the normalized uri to out (with a single allocation at most)
+// returns the split of the normalized uri which points into out
+inline uri_split normalize_uri(opt_string_view uri, std::string& out)
+{
+    auto offset = out.size();
+    out.resize(offset + capi::furi_normalize_uri_max_length(uri.size()));
+    char* begin = out.data() + offset;
+    auto s = capi::furi_normalize_uri(uri.c_sv(), begin);
+    out.resize(s.req_path.begin ? s.req_path.end - out.data() : offset);
+    return uri_split::from_capi(s);
+}
+
+inline std::string normalize_uri(opt_string_view uri)
+{
+    std::string ret;
+    normalize_uri(uri, ret);
+    return ret;
+}
+
+}
@@ -0,0 +1,213 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+#include "normalize.h" // furi_remove_dot_segments
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// reference split
+// splits a uri reference (RFC 3986 4.1) which may be relative
+// unlike furi_split_uri:
+//  * a scheme is only recognized if ':' comes before any '/', '?', or '#'
+//  * "//" starts an authority even without a scheme (network-path reference)
+//  * the authority ends at '/', '?', or '#'
+//  * query and fragment are recognized in references with no '/'
+//  * path is never null (but may be empty) and req_path is always [path.begin, end)
+FURI_INLINE furi_uri_split furi_split_reference(furi_sv u)
+{
+    furi_uri_split ret = FURI_EMPTY_VAL;
+    if (furi_sv_is_null(u)) return ret;
+
+    for (const char* p = u.begin; p != u.end; ++p)
+    {
+        char c = *p;
+        if (c == ':')
+        {
+            ret.scheme = furi_make_sv(u.begin, p);
+            u.begin = p + 1;
+            break;
+        }
+        if (c == '/' || c == '?' || c == '#') break;
+    }
+
+    if (furi_sv_starts_with(u, "//"))
+    {
+        u.begin += 2;
+        const char* p = u.begin;
+        while (p != u.end && *p != '/' && *p != '?' && *p != '#') ++p;
+        ret.authority = furi_make_sv(u.begin, p);
+        u.begin = p;
+    }
+
+    ret.req_path = u;
+    ret.path = u;
+
+    const char* p = furi_find2(u.begin, u.end, '?', '#');
+    if (!p) return ret;
+
+    ret.path.end = p;
+    if (*p == '?')
+    {
+        ret.query = furi_make_sv(p + 1, u.end);
+        p = furi_sv_find_first(ret.query, '#');
+        if (!p) return ret;
+        ret.query.end = p;
+    }
+    ret.fragment = furi_make_sv(p + 1, u.end);
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// reference resolution (RFC 3986 5.2)
+// base is an absolute uri (split with furi_split_uri or furi_split_reference)
+// ref is split with furi_split_reference
+// the result is written to out and its reference split is returned
+// the resolved uri is [out, req_path.end)
+
+// out must have room for at least this many chars
+FURI_INLINE size_t furi_resolve_max_length(const furi_uri_split* base, const furi_uri_split* ref)
+{
+#define FURI_RESOLVE_MAX_LEN(a, b) (furi_sv_length(a) > furi_sv_length(b) ? furi_sv_length(a) : furi_sv_length(b))
+    return FURI_RESOLVE_MAX_LEN(base->scheme, ref->scheme) + 1
+        + FURI_RESOLVE_MAX_LEN(base->authority, ref->authority) + 2
+        + furi_sv_length(base->path) + 1 + furi_sv_length(ref->path)
+        + FURI_RESOLVE_MAX_LEN(base->query, ref->query) + 1
+        + furi_sv_length(ref->fragment) + 1;
+#undef FURI_RESOLVE_MAX_LEN
+}
+
+FURI_INLINE char* furi_resolve_write(char* o, furi_sv sv)
+{
+    size_t len = furi_sv_length(sv);
+    if (len) memcpy(o, sv.begin, len);
+    return o + len;
+}
+
+FURI_INLINE furi_uri_split furi_resolve_reference(const furi_uri_split* base, const furi_uri_split* ref, char* out)
+{
+    furi_uri_split ret = FURI_EMPTY_VAL;
+
+    // pick the source of each component
+    furi_sv scheme = base->scheme;
+    furi_sv authority = base->authority;
+    furi_sv query = ref->query;
+    bool ref_path = true; // path is taken from ref (otherwise base)
+    bool merge = false; // ref path is merged with the base path
+
+    if (ref->scheme.begin)
+    {
+        scheme = ref->scheme;
+        authority = ref->authority;
+    }
+    else if (ref->authority.begin)
+    {
+        authority = ref->authority;
+    }
+    else if (furi_sv_is_empty(ref->path))
+    {
+        ref_path = false;
+        if (!query.begin) query = base->query;
+    }
+    else if (ref->path.begin[0] != '/')
+    {
+        merge = true;
+    }
+
+    char* o = out;
+    if (scheme.begin)
+    {
+        o = furi_resolve_write(o, scheme);
+        ret.scheme = furi_make_sv(out, o);
+        *o++ = ':';
+    }
+
+    if (authority.begin)
+    {
+        *o++ = '/';
+        *o++ = '/';
+        char* abegin = o;
+        o = furi_resolve_write(o, authority);
+        ret.authority = furi_make_sv(abegin, o);
+    }
+
+    char* pbegin = o;
+    if (!ref_path)
+    {
+        o = furi_resolve_write(o, base->path);
+    }
+    else
+    {
+        if (merge)
+        {
+            if (base->authority.begin && furi_sv_is_empty(base->path))
+            {
+                *o++ = '/';
+            }
+            else
+            {
+                const char* slash = furi_sv_find_last(base->path, '/');
+                if (slash) o = furi_resolve_write(o, furi_make_sv(base->path.begin, slash + 1));
+            }
+        }
+        o = furi_resolve_write(o, ref->path);
+        o = furi_remove_dot_segments(pbegin, o);
+    }
+    ret.path = furi_make_sv(pbegin, o);
+
+    if (query.begin)
+    {
+        *o++ = '?';
+        char* qbegin = o;
+        o = furi_resolve_write(o, query);
+        ret.query = furi_make_sv(qbegin, o);
+    }
+
+    if (ref->fragment.begin)
+    {
+        *o++ = '#';
+        char* fbegin = o;
+        o = furi_resolve_write(o, ref->fragment);
+        ret.fragment = furi_make_sv(fbegin, o);
+    }
+
+    ret.req_path = furi_make_sv(pbegin, o);
+    return ret;
+}
+
+FURI_INLINE furi_uri_split furi_resolve_uri(furi_sv base, furi_sv ref, char* out)
+{
+    furi_uri_split bs = furi_split_reference(base);
+    furi_uri_split rs = furi_split_reference(ref);
+    return furi_resolve_reference(&bs, &rs, out);
+}
+
+// resolves refs against a single base which is split only once
+// the resolved uris are written one after the other in out and their splits to results
+// returns the number of resolved refs which is less than n if out_size is not enough
+FURI_INLINE size_t furi_resolve_batch(const furi_uri_split* base, const furi_sv* refs, size_t n,
+    char* out, size_t out_size, furi_uri_split* results)
+{
+    char* o = out;
+    char* const end = out + out_size;
+    for (size_t i = 0; i < n; ++i)
+    {
+        furi_uri_split rs = furi_split_reference(refs[i]);
+        if (furi_resolve_max_length(base, &rs) > (size_t)(end - o)) return i;
+        results[i] = furi_resolve_reference(base, &rs, o);
+        o = (char*)results[i].req_path.end;
+    }
+    return n;
+}
+
+#if defined(__cplusplus)
+}
+#endif
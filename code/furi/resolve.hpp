@@ -0,0 +1,44 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "resolve.h"
+
+namespace furi
+{
+
+inline uri_split split_reference(opt_string_view ref) noexcept
+{
+    return uri_split::from_capi(capi::furi_split_reference(ref.c_sv()));
+}
+
+// resolves references against a base which is split only once
+class uri_resolver
+{
+    capi::furi_uri_split m_base;
+public:
+    explicit uri_resolver(opt_string_view base) noexcept
+        : m_base(capi::furi_split_reference(base.c_sv()))
+    {}
+
+    // appends the resolved uri to out and returns its split which points into out
+    uri_split resolve(opt_string_view ref, std::string& out) const
+    {
+        auto rs = capi::furi_split_reference(ref.c_sv());
+        auto offset = out.size();
+        out.resize(offset + capi::furi_resolve_max_length(&m_base, &rs));
+        auto s = capi::furi_resolve_reference(&m_base, &rs, out.data() + offset);
+        out.resize(s.req_path.end - out.data());
+        return uri_split::from_capi(s);
+    }
+
+    std::string resolve(opt_string_view ref) const
+    {
+        std::string ret;
+        resolve(ref, ret);
+        return ret;
+    }
+};
+
+}
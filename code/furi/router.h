@@ -0,0 +1,294 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// path router
+// a radix tree over path segments
+// route patterns are paths whose segments are one of:
+//  * static text which must match exactly
+//  * ":name" which captures a single non-empty segment
+//  * "*" or "*name" (last segment only) which captures the rest of the path
+// segments are the ones of furi_path_iter: "/a/b" and "a/b" are the same, "/a/" is "a" and ""
+// chains of static segments are stored as a single node: "/users/list" is one node unless another
+// route shares only "users"
+// when more than one route matches a path, static segments win over captures and
+// captures of a segment win over captures of the rest
+//
+// the router doesn't allocate: nodes are provided by the caller
+// patterns are not copied and must outlive the router
+
+#define FURI_ROUTER_NONE UINT32_MAX
+#define FURI_ROUTER_MAX_CAPTURES 8
+
+typedef struct furi_router_node
+{
+    furi_sv label; // static segments separated by '/' (empty for capture nodes)
+    uint32_t next; // next static sibling
+    uint32_t children; // first static child
+    uint32_t param; // child which captures a segment
+    uint32_t wildcard; // child which captures the rest of the path
+    int route; // route which ends here or -1
+} furi_router_node;
+
+typedef struct furi_router
+{
+    furi_router_node* nodes;
+    uint32_t capacity;
+    uint32_t size;
+} furi_router;
+
+typedef enum furi_router_add_result
+{
+    FURI_ROUTER_ADDED,
+    FURI_ROUTER_DUPLICATE, // a route with the same pattern exists
+    FURI_ROUTER_INVALID_PATTERN, // wildcard which is not last or too many captures
+    FURI_ROUTER_OUT_OF_NODES
+} furi_router_add_result;
+
+typedef struct furi_router_match
+{
+    int route; // -1 if no route matches
+    uint32_t num_captures;
+    furi_sv captures[FURI_ROUTER_MAX_CAPTURES]; // in pattern order
+} furi_router_match;
+
+FURI_INLINE uint32_t furi_router_new_node(furi_router* r, furi_sv label)
+{
+    uint32_t i = r->size++;
+    furi_router_node* n = r->nodes + i;
+    n->label = label;
+    n->next = FURI_ROUTER_NONE;
+    n->children = FURI_ROUTER_NONE;
+    n->param = FURI_ROUTER_NONE;
+    n->wildcard = FURI_ROUTER_NONE;
+    n->route = -1;
+    return i;
+}
+
+// capacity must be at least 1 (for the root)
+FURI_INLINE furi_router furi_make_router(furi_router_node* nodes, uint32_t capacity)
+{
+    assert(capacity > 0);
+    furi_router ret = {nodes, capacity, 0};
+    furi_router_new_node(&ret, FURI_EMPTY_T(furi_sv));
+    return ret;
+}
+
+// the number of nodes a pattern needs at most: two per segment
+FURI_INLINE uint32_t furi_router_max_nodes(furi_sv pattern)
+{
+    uint32_t segments = 1;
+    for (const char* p = pattern.begin; p != pattern.end; ++p) segments += *p == '/';
+    return 2 * segments;
+}
+
+// the length of the common prefix of two runs of segments which ends at a segment boundary in both
+// -1 if their first segments differ
+FURI_INLINE long furi_router_common_segments(furi_sv a, furi_sv b)
+{
+    size_t la = furi_sv_length(a);
+    size_t lb = furi_sv_length(b);
+    long ret = -1;
+    for (size_t i = 0; ; ++i)
+    {
+        bool ea = i == la, eb = i == lb;
+        bool sa = ea || a.begin[i] == '/';
+        bool sb = eb || b.begin[i] == '/';
+        if (sa && sb)
+        {
+            ret = (long)i;
+            if (ea || eb) break;
+            continue;
+        }
+        if (sa || sb || a.begin[i] != b.begin[i]) break;
+    }
+    return ret;
+}
+
+// adds the static segments of run under node n, splitting nodes if needed
+// returns the node where run ends
+FURI_INLINE uint32_t furi_router_add_static(furi_router* r, uint32_t n, furi_sv run)
+{
+    for (;;)
+    {
+        uint32_t* link = &r->nodes[n].children;
+        bool descended = false;
+        for (; *link != FURI_ROUTER_NONE; link = &r->nodes[*link].next)
+        {
+            uint32_t c = *link;
+            long common = furi_router_common_segments(r->nodes[c].label, run);
+            if (common < 0) continue;
+            size_t len = (size_t)common;
+
+            if (len < furi_sv_length(r->nodes[c].label))
+            {
+                // split c: the common part becomes its parent
+                furi_sv label = r->nodes[c].label;
+                uint32_t m = furi_router_new_node(r, furi_make_sv(label.begin, label.begin + len));
+                r->nodes[m].next = r->nodes[c].next;
+                r->nodes[m].children = c;
+                r->nodes[c].next = FURI_ROUTER_NONE;
+                r->nodes[c].label.begin += len + 1; // skip the '/'
+                *link = m;
+                c = m;
+            }
+
+            if (len == furi_sv_length(run)) return c;
+            run.begin += len + 1;
+            n = c;
+            descended = true;
+            break;
+        }
+
+        if (!descended)
+        {
+            uint32_t c = furi_router_new_node(r, run);
+            *link = c;
+            return c;
+        }
+    }
+}
+
+// at most FURI_ROUTER_MAX_CAPTURES captures and "*" only as the last segment
+FURI_INLINE bool furi_router_is_valid_pattern(furi_sv pattern)
+{
+    uint32_t captures = 0;
+    bool at_segment_begin = true;
+    for (const char* p = pattern.begin; p != pattern.end; ++p)
+    {
+        if (at_segment_begin && (*p == ':' || *p == '*'))
+        {
+            if (++captures > FURI_ROUTER_MAX_CAPTURES) return false;
+            if (*p == '*' && furi_find2(p, pattern.end, '/', '/')) return false;
+        }
+        at_segment_begin = *p == '/';
+    }
+    return true;
+}
+
+// route is an id of the caller's choosing (non-negative) which furi_router_match_path returns
+FURI_INLINE furi_router_add_result furi_router_add(furi_router* r, furi_sv pattern, int route)
+{
+    assert(route >= 0);
+    if (!furi_router_is_valid_pattern(pattern)) return FURI_ROUTER_INVALID_PATTERN;
+    if (r->capacity - r->size < furi_router_max_nodes(pattern)) return FURI_ROUTER_OUT_OF_NODES;
+
+    // the same segments as furi_path_iter: "" has none, "/" has an empty one
+    const char* p = pattern.begin;
+    const char* end = pattern.end;
+    bool done = furi_sv_is_empty(pattern);
+    if (!done && *p == '/') ++p;
+
+    uint32_t n = 0;
+    while (!done)
+    {
+        const char* seg_end = furi_find2(p, end, '/', '/');
+        if (!seg_end) seg_end = end;
+
+        if (p != seg_end && (*p == ':' || *p == '*'))
+        {
+            uint32_t* child = *p == '*' ? &r->nodes[n].wildcard : &r->nodes[n].param;
+            if (*child == FURI_ROUTER_NONE) *child = furi_router_new_node(r, FURI_EMPTY_T(furi_sv));
+            n = *child;
+        }
+        else
+        {
+            // the longest run of static segments from here
+            const char* run_end = seg_end;
+            while (run_end != end)
+            {
+                const char* next = run_end + 1;
+                if (next != end && (*next == ':' || *next == '*')) break;
+                const char* e = furi_find2(next, end, '/', '/');
+                run_end = e ? e : end;
+            }
+            n = furi_router_add_static(r, n, furi_make_sv(p, run_end));
+            seg_end = run_end;
+        }
+
+        done = seg_end == end;
+        p = seg_end + 1;
+    }
+
+    if (r->nodes[n].route >= 0) return FURI_ROUTER_DUPLICATE;
+    r->nodes[n].route = route;
+    return FURI_ROUTER_ADDED;
+}
+
+// p is the beginning of the next segment or NULL if there are no more segments
+FURI_INLINE int furi_router_match_node(const furi_router* r, uint32_t n, const char* p, const char* end,
+    furi_router_match* m)
+{
+    const furi_router_node* node = r->nodes + n;
+    if (!p) return node->route;
+
+    for (uint32_t c = node->children; c != FURI_ROUTER_NONE; c = r->nodes[c].next)
+    {
+        furi_sv label = r->nodes[c].label;
+        size_t len = furi_sv_length(label);
+        if ((size_t)(end - p) < len) continue;
+        if (len && *p != *label.begin) continue;
+        if (p + len != end && p[len] != '/') continue;
+        if (memcmp(p, label.begin, len) != 0) continue;
+
+        int route = furi_router_match_node(r, c, p + len == end ? NULL : p + len + 1, end, m);
+        if (route >= 0) return route;
+    }
+
+    if (node->param != FURI_ROUTER_NONE)
+    {
+        const char* seg_end = furi_find2(p, end, '/', '/');
+        if (!seg_end) seg_end = end;
+        if (seg_end != p)
+        {
+            uint32_t i = m->num_captures++;
+            m->captures[i] = furi_make_sv(p, seg_end);
+            int route = furi_router_match_node(r, node->param, seg_end == end ? NULL : seg_end + 1, end, m);
+            if (route >= 0) return route;
+            m->num_captures = i;
+        }
+    }
+
+    if (node->wildcard != FURI_ROUTER_NONE)
+    {
+        int route = r->nodes[node->wildcard].route;
+        if (route >= 0)
+        {
+            m->captures[m->num_captures++] = furi_make_sv(p, end);
+            return route;
+        }
+    }
+
+    return -1;
+}
+
+// matches a path (for example the path of a furi_uri_split)
+FURI_INLINE furi_router_match furi_router_match_path(const furi_router* r, furi_sv path)
+{
+    furi_router_match ret;
+    ret.num_captures = 0;
+
+    // the same segments as furi_path_iter
+    const char* p = path.begin;
+    if (furi_sv_is_empty(path)) p = NULL;
+    else if (*p == '/') ++p;
+
+    ret.route = furi_router_match_node(r, 0, p, path.end, &ret);
+    if (ret.route < 0) ret.num_captures = 0;
+    return ret;
+}
+
+#if defined(__cplusplus)
+}
+#endif
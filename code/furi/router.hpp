@@ -0,0 +1,120 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "router.h"
+#include <array>
+#include <deque>
+
+namespace furi
+{
+
+// routes paths to handlers of a type of the caller's choosing
+// the router owns copies of the patterns and grows its nodes as needed
+// unlike the C router, capture names are kept, so captures can be looked up by name
+template <typename Handler>
+class router
+{
+public:
+    class match_result
+    {
+        friend class router;
+        const Handler* m_handler = nullptr;
+        const std::vector<std::string_view>* m_names = nullptr;
+        size_t m_num_captures = 0;
+        std::array<opt_string_view, FURI_ROUTER_MAX_CAPTURES> m_captures = {};
+    public:
+        explicit operator bool() const noexcept { return !!m_handler; }
+
+        // null if no route matches
+        const Handler* handler() const noexcept { return m_handler; }
+
+        size_t num_captures() const noexcept { return m_num_captures; }
+
+        // captures in pattern order
+        opt_string_view capture(size_t i) const noexcept
+        {
+            return i < m_num_captures ? m_captures[i] : opt_string_view();
+        }
+
+        // null if the matched pattern has no capture with this name
+        opt_string_view capture(std::string_view name) const noexcept
+        {
+            if (!m_names) return {};
+            for (size_t i = 0; i < m_names->size(); ++i)
+            {
+                if ((*m_names)[i] == name) return m_captures[i];
+            }
+            return {};
+        }
+    };
+
+    router()
+        : m_nodes(1)
+    {
+        m_router = capi::furi_make_router(m_nodes.data(), 1);
+    }
+
+    router(const router&) = delete;
+    router& operator=(const router&) = delete;
+
+    // see furi_router_add for the pattern syntax
+    capi::furi_router_add_result add(std::string_view pattern, Handler handler)
+    {
+        const std::string& p = m_patterns.emplace_back(pattern);
+        capi::furi_sv sv = opt_string_view(p).c_sv();
+
+        m_nodes.resize(m_router.size + capi::furi_router_max_nodes(sv));
+        m_router.nodes = m_nodes.data();
+        m_router.capacity = uint32_t(m_nodes.size());
+
+        auto result = capi::furi_router_add(&m_router, sv, int(m_routes.size()));
+        m_nodes.resize(m_router.size);
+        if (result != capi::FURI_ROUTER_ADDED)
+        {
+            m_patterns.pop_back();
+            return result;
+        }
+
+        auto& r = m_routes.emplace_back(route{std::move(handler), {}});
+        if (pattern.empty()) return result; // no segments, no captures
+        for (auto pi = capi::furi_make_path_iter_begin(sv); !capi::furi_path_iter_is_done(pi); capi::furi_path_iter_next(&pi))
+        {
+            opt_string_view seg(capi::furi_path_iter_get_value(pi));
+            if (seg.empty() || (seg[0] != ':' && seg[0] != '*')) continue;
+            r.capture_names.push_back(seg.substr(1));
+        }
+        return result;
+    }
+
+    [[nodiscard]] match_result match(std::string_view path) const noexcept
+    {
+        match_result ret;
+        auto m = capi::furi_router_match_path(&m_router, opt_string_view(path).c_sv());
+        if (m.route < 0) return ret;
+        const route& r = m_routes[size_t(m.route)];
+        ret.m_handler = &r.handler;
+        ret.m_names = &r.capture_names;
+        ret.m_num_captures = m.num_captures;
+        for (uint32_t i = 0; i < m.num_captures; ++i) ret.m_captures[i] = opt_string_view(m.captures[i]);
+        return ret;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_routes.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_routes.empty(); }
+
+private:
+    struct route
+    {
+        Handler handler;
+        std::vector<std::string_view> capture_names;
+    };
+
+    std::deque<std::string> m_patterns; // node labels point into these, so they must not move
+    std::vector<capi::furi_router_node> m_nodes;
+    std::vector<route> m_routes;
+    capi::furi_router m_router;
+};
+
+}
@@ -0,0 +1,214 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// uri store
+// bulk storage for large numbers of uris, addressed by 32-bit handles
+// the texts are appended back to back into pages and split once when added
+// the splits are kept in a side table of 20-byte entries (a furi_uri_split_compact with 16-bit offsets
+// and the location of the text), indexed by the handles
+// handles are issued in order and never reused, so the handles of a page are a contiguous range
+// pages can be released as a whole which invalidates their handles
+//
+// the store doesn't allocate: pages and tables are provided by the caller
+// when an add reports FURI_URI_STORE_OUT_OF_PAGE_SPACE, the caller adds a page with a capacity of
+// at least the length of the uri and retries
+// uris must be at most FURI_URI_STORE_MAX_LENGTH bytes
+
+#define FURI_URI_STORE_MAX_LENGTH UINT16_MAX
+
+typedef struct furi_uri_store_entry
+{
+    uint32_t page;
+    uint32_t offset; // of the text in the page
+    // as in furi_uri_split_compact
+    uint16_t scheme_end;
+    uint16_t path_begin;
+    uint16_t path_end;
+    uint16_t query_end;
+    uint16_t length;
+    uint8_t flags;
+} furi_uri_store_entry;
+
+typedef struct furi_uri_store_page
+{
+    char* data; // null if released
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t first; // the handles of the page are [first, end)
+    uint32_t end;
+} furi_uri_store_page;
+
+typedef struct furi_uri_store
+{
+    furi_uri_store_entry* entries;
+    uint32_t entry_capacity;
+    uint32_t size; // number of issued handles
+    furi_uri_store_page* pages;
+    uint32_t page_capacity;
+    uint32_t num_pages;
+} furi_uri_store;
+
+typedef enum furi_uri_store_add_result
+{
+    FURI_URI_STORE_ADDED,
+    FURI_URI_STORE_TOO_LONG,
+    FURI_URI_STORE_OUT_OF_ENTRIES,
+    FURI_URI_STORE_OUT_OF_PAGE_SPACE // the last page can't fit the uri (or there are no pages)
+} furi_uri_store_add_result;
+
+FURI_INLINE furi_uri_store furi_make_uri_store(furi_uri_store_entry* entries, uint32_t entry_capacity,
+    furi_uri_store_page* pages, uint32_t page_capacity)
+{
+    furi_uri_store ret = FURI_EMPTY_VAL;
+    ret.entries = entries;
+    ret.entry_capacity = entry_capacity;
+    ret.pages = pages;
+    ret.page_capacity = page_capacity;
+    return ret;
+}
+
+// new uris are added to the page until it's full
+// returns false if the page table is full
+FURI_INLINE bool furi_uri_store_add_page(furi_uri_store* s, char* data, uint32_t capacity)
+{
+    if (s->num_pages == s->page_capacity) return false;
+    furi_uri_store_page* p = s->pages + s->num_pages++;
+    p->data = data;
+    p->capacity = capacity;
+    p->used = 0;
+    p->first = s->size;
+    p->end = s->size;
+    return true;
+}
+
+// copies the uri to the last page and splits it
+// a null uri is stored as an empty text with all components null
+FURI_INLINE furi_uri_store_add_result furi_uri_store_add(furi_uri_store* s, furi_sv uri, uint32_t* out_handle)
+{
+    size_t length = furi_sv_length(uri);
+    if (length > FURI_URI_STORE_MAX_LENGTH) return FURI_URI_STORE_TOO_LONG;
+    if (s->size == s->entry_capacity) return FURI_URI_STORE_OUT_OF_ENTRIES;
+    if (!s->num_pages) return FURI_URI_STORE_OUT_OF_PAGE_SPACE;
+
+    furi_uri_store_page* p = s->pages + s->num_pages - 1;
+    if (!p->data || p->capacity - p->used < length) return FURI_URI_STORE_OUT_OF_PAGE_SPACE;
+
+    char* text = p->data + p->used;
+    if (length) memcpy(text, uri.begin, length);
+
+    furi_uri_split_compact c = furi_split_uri_compact(furi_make_sv(text, text + length));
+    if (furi_sv_is_null(uri)) c.flags = 0;
+
+    furi_uri_store_entry* e = s->entries + s->size;
+    e->page = s->num_pages - 1;
+    e->offset = p->used;
+    e->scheme_end = (uint16_t)c.scheme_end;
+    e->path_begin = (uint16_t)c.path_begin;
+    e->path_end = (uint16_t)c.path_end;
+    e->query_end = (uint16_t)c.query_end;
+    e->length = (uint16_t)c.length;
+    e->flags = c.flags;
+
+    p->used += (uint32_t)length;
+    p->end = ++s->size;
+    *out_handle = p->end - 1;
+    return FURI_URI_STORE_ADDED;
+}
+
+// true if the handle was issued and its page hasn't been released
+FURI_INLINE bool furi_uri_store_contains(const furi_uri_store* s, uint32_t handle)
+{
+    return handle < s->size && s->pages[s->entries[handle].page].data;
+}
+
+// the functions below expect a handle for which furi_uri_store_contains is true
+
+FURI_INLINE const char* furi_uri_store_text(const furi_uri_store* s, uint32_t handle)
+{
+    const furi_uri_store_entry* e = s->entries + handle;
+    return s->pages[e->page].data + e->offset;
+}
+
+FURI_INLINE furi_uri_split_compact furi_uri_store_get_compact(const furi_uri_store* s, uint32_t handle)
+{
+    const furi_uri_store_entry* e = s->entries + handle;
+    furi_uri_split_compact ret;
+    ret.scheme_end = e->scheme_end;
+    ret.path_begin = e->path_begin;
+    ret.path_end = e->path_end;
+    ret.query_end = e->query_end;
+    ret.length = e->length;
+    ret.flags = e->flags;
+    return ret;
+}
+
+FURI_INLINE furi_sv furi_uri_store_get_uri(const furi_uri_store* s, uint32_t handle)
+{
+    const char* text = furi_uri_store_text(s, handle);
+    return furi_make_sv(text, text + s->entries[handle].length);
+}
+
+FURI_INLINE furi_sv furi_uri_store_get(const furi_uri_store* s, uint32_t handle, furi_uri_component component)
+{
+    furi_uri_split_compact c = furi_uri_store_get_compact(s, handle);
+    return furi_uri_split_compact_get(&c, furi_uri_store_text(s, handle), component);
+}
+
+FURI_INLINE furi_uri_split furi_uri_store_get_split(const furi_uri_store* s, uint32_t handle)
+{
+    furi_uri_split_compact c = furi_uri_store_get_compact(s, handle);
+    return furi_uri_split_from_compact(&c, furi_uri_store_text(s, handle));
+}
+
+// iteration over the live handles:
+// for (uint32_t h = furi_uri_store_first(s); h < s->size; h = furi_uri_store_next(s, h))
+// the released pages are skipped as a whole
+
+FURI_INLINE uint32_t furi_uri_store_skip_released(const furi_uri_store* s, uint32_t handle)
+{
+    while (handle < s->size)
+    {
+        const furi_uri_store_page* p = s->pages + s->entries[handle].page;
+        if (p->data) break;
+        handle = p->end;
+    }
+    return handle;
+}
+
+FURI_INLINE uint32_t furi_uri_store_first(const furi_uri_store* s)
+{
+    return furi_uri_store_skip_released(s, 0);
+}
+
+FURI_INLINE uint32_t furi_uri_store_next(const furi_uri_store* s, uint32_t handle)
+{
+    return furi_uri_store_skip_released(s, handle + 1);
+}
+
+// invalidates the handles of the page and returns its data so the caller can free it
+// returns null if the page was already released
+// no more uris are added to the page, even if it's the last one
+FURI_INLINE char* furi_uri_store_release_page(furi_uri_store* s, uint32_t page)
+{
+    furi_uri_store_page* p = s->pages + page;
+    char* ret = p->data;
+    p->data = NULL;
+    p->used = p->capacity;
+    return ret;
+}
+
+#if defined(__cplusplus)
+}
+#endif
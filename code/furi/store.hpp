@@ -0,0 +1,174 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "store.h"
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace furi
+{
+
+// an owning capi::furi_uri_store
+// pages are allocated as needed with a size of page_size (or the length of the uri if it's longer)
+// and the entry and page tables grow like vectors
+class uri_store
+{
+public:
+    using handle = uint32_t;
+
+    static constexpr uint32_t default_page_size = 1024 * 1024;
+    static constexpr size_t max_uri_length = FURI_URI_STORE_MAX_LENGTH;
+
+    explicit uri_store(uint32_t page_size = default_page_size)
+        : m_page_size(page_size)
+    {
+        m_store = capi::furi_make_uri_store(nullptr, 0, nullptr, 0);
+    }
+
+    uri_store(const uri_store&) = delete;
+    uri_store& operator=(const uri_store&) = delete;
+
+    // the tables and pages keep their buffers, so handles and views stay valid
+    // the moved-from store is empty
+    uri_store(uri_store&& other) noexcept
+        : m_page_size(other.m_page_size)
+        , m_entries(std::move(other.m_entries))
+        , m_pages(std::move(other.m_pages))
+        , m_page_data(std::move(other.m_page_data))
+        , m_store(std::exchange(other.m_store, capi::furi_make_uri_store(nullptr, 0, nullptr, 0)))
+    {
+        other.clear_tables();
+    }
+
+    uri_store& operator=(uri_store&& other) noexcept
+    {
+        if (this == &other) return *this;
+        m_page_size = other.m_page_size;
+        m_entries = std::move(other.m_entries);
+        m_pages = std::move(other.m_pages);
+        m_page_data = std::move(other.m_page_data);
+        m_store = std::exchange(other.m_store, capi::furi_make_uri_store(nullptr, 0, nullptr, 0));
+        other.clear_tables();
+        return *this;
+    }
+
+    // reserves entries for a total of n uris
+    void reserve(size_t n)
+    {
+        if (n > m_entries.size()) set_entries(n);
+    }
+
+    // returns nullopt if the uri is longer than max_uri_length
+    std::optional<handle> add(opt_string_view uri)
+    {
+        if (uri.size() > max_uri_length) return std::nullopt;
+
+        if (m_store.size == m_store.entry_capacity) set_entries(m_entries.empty() ? 1024 : m_entries.size() * 2);
+
+        handle ret;
+        auto result = capi::furi_uri_store_add(&m_store, uri.c_sv(), &ret);
+        if (result == capi::FURI_URI_STORE_OUT_OF_PAGE_SPACE)
+        {
+            new_page(std::max(m_page_size, uint32_t(uri.size())));
+            result = capi::furi_uri_store_add(&m_store, uri.c_sv(), &ret);
+        }
+        assert(result == capi::FURI_URI_STORE_ADDED);
+        return ret;
+    }
+
+    // true if the handle was issued and its page hasn't been released
+    [[nodiscard]] bool contains(handle h) const noexcept { return capi::furi_uri_store_contains(&m_store, h); }
+
+    // the accessors below expect a handle for which contains is true
+    // the views are valid until the page of the handle is released or the store is destroyed
+
+    [[nodiscard]] opt_string_view str(handle h) const noexcept
+    {
+        return opt_string_view(capi::furi_uri_store_get_uri(&m_store, h));
+    }
+
+    [[nodiscard]] opt_string_view get(handle h, capi::furi_uri_component c) const noexcept
+    {
+        return opt_string_view(capi::furi_uri_store_get(&m_store, h, c));
+    }
+
+    [[nodiscard]] uri_split split(handle h) const noexcept
+    {
+        return uri_split::from_capi(capi::furi_uri_store_get_split(&m_store, h));
+    }
+
+    // calls f(handle, uri_split) for the live uris in handle order
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (handle h = capi::furi_uri_store_first(&m_store); h < m_store.size; h = capi::furi_uri_store_next(&m_store, h))
+        {
+            f(h, split(h));
+        }
+    }
+
+    // the number of issued handles (including the ones of released pages)
+    [[nodiscard]] size_t size() const noexcept { return m_store.size; }
+
+    [[nodiscard]] size_t num_pages() const noexcept { return m_store.num_pages; }
+
+    // the handles of a page are [first, second)
+    [[nodiscard]] std::pair<handle, handle> page_handles(size_t page) const noexcept
+    {
+        auto& p = m_store.pages[page];
+        return {p.first, p.end};
+    }
+
+    // the page of a handle (the pages are numbered in order of allocation)
+    [[nodiscard]] size_t page_of(handle h) const noexcept { return m_store.entries[h].page; }
+
+    // frees the memory of a page and invalidates its handles
+    void release_page(size_t page) noexcept
+    {
+        capi::furi_uri_store_release_page(&m_store, uint32_t(page));
+        m_page_data[page].reset();
+    }
+
+    const capi::furi_uri_store& c_store() const noexcept { return m_store; }
+
+private:
+    // the moved-from vectors are only valid but unspecified
+    void clear_tables() noexcept
+    {
+        m_entries.clear();
+        m_pages.clear();
+        m_page_data.clear();
+    }
+
+    void set_entries(size_t n)
+    {
+        m_entries.resize(n);
+        m_store.entries = m_entries.data();
+        m_store.entry_capacity = uint32_t(std::min<size_t>(n, UINT32_MAX));
+    }
+
+    void new_page(uint32_t capacity)
+    {
+        if (m_store.num_pages == m_store.page_capacity)
+        {
+            m_pages.resize(m_pages.empty() ? 16 : m_pages.size() * 2);
+            m_store.pages = m_pages.data();
+            m_store.page_capacity = uint32_t(m_pages.size());
+        }
+        auto& data = m_page_data.emplace_back(new char[capacity]);
+        capi::furi_uri_store_add_page(&m_store, data.get(), capacity);
+    }
+
+    uint32_t m_page_size;
+    std::vector<capi::furi_uri_store_entry> m_entries;
+    std::vector<capi::furi_uri_store_page> m_pages;
+    std::vector<std::unique_ptr<char[]>> m_page_data;
+    capi::furi_uri_store m_store;
+};
+
+}
@@ -0,0 +1,455 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.h"
+
+#if defined(__cplusplus)
+#   if defined FURI_CPP_NAMESPACE
+        namespace FURI_CPP_NAMESPACE {
+#   else
+        extern "C" {
+#   endif
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// host suffix trie
+// a trie over the labels of domain suffix rules from right to left
+// for public suffix lists, cookie scopes, or per-domain settings
+// rules are the ones of the public suffix list:
+//  * "com", "co.uk", "example.com" match hosts which are or end with them
+//  * "*.ck" matches any label in place of the "*" (only as the leftmost label)
+//  * "!www.ck" is an exception to a wildcard: "ck" is the suffix of "www.ck" and its subdomains
+//  * "*" alone is the implicit rule of the public suffix list (any top level label), which is
+//    not applied unless it's in the rules
+// a match walks the host once from right to left and returns the longest matching suffix
+// and the registrable domain (the suffix and one more label)
+// labels are matched case-insensitively (see furi_sv_icmp)
+//
+// the nodes are in a flat array (16 bytes each), the children of a node are contiguous
+// and sorted, and the labels are in a single char array
+// the build doesn't allocate: nodes, chars, and scratch space are provided by the caller
+// the trie can be saved as a blob and used from it without copying
+
+#define FURI_SUFFIX_NONE UINT32_MAX
+
+typedef enum furi_suffix_node_flags
+{
+    FURI_SUFFIX_EXCEPTION = 1, // the rule which ends here is an exception
+    FURI_SUFFIX_WILDCARD = 2, // the first child is "*"
+} furi_suffix_node_flags;
+
+typedef struct furi_suffix_node
+{
+    uint32_t label; // offset of the label in the chars of the trie
+    uint32_t children; // index of the first child
+    uint32_t rule; // index of the rule which ends here or FURI_SUFFIX_NONE
+    uint16_t num_children;
+    uint8_t label_length;
+    uint8_t flags; // furi_suffix_node_flags
+} furi_suffix_node;
+
+typedef struct furi_suffix_trie
+{
+    const furi_suffix_node* nodes; // the first one is the root
+    uint32_t num_nodes;
+    const char* chars; // labels (lowercase)
+    uint32_t num_chars;
+} furi_suffix_trie;
+
+typedef enum furi_suffix_build_result
+{
+    FURI_SUFFIX_BUILT,
+    FURI_SUFFIX_INVALID_RULE, // see furi_suffix_rule_is_valid
+    FURI_SUFFIX_DUPLICATE, // two rules with the same labels
+    FURI_SUFFIX_TOO_MANY_CHILDREN, // more than UINT16_MAX labels after the same suffix
+    FURI_SUFFIX_OUT_OF_NODES,
+    FURI_SUFFIX_OUT_OF_CHARS
+} furi_suffix_build_result;
+
+typedef struct furi_suffix_match
+{
+    uint32_t rule; // index of the matching rule or FURI_SUFFIX_NONE
+    furi_sv suffix; // the part of the host matched by the rule (null if there is no match)
+    furi_sv domain; // the suffix and the label before it (null if there is no match or no such label)
+} furi_suffix_match;
+
+///////////////////////////////////////////////////////////////////////////////
+// rules
+
+FURI_INLINE bool furi_suffix_is_wildcard(furi_sv label)
+{
+    return furi_sv_length(label) == 1 && *label.begin == '*';
+}
+
+// "*" sorts before all other labels, so it's the first child of a node
+FURI_INLINE int furi_suffix_label_cmp(furi_sv a, furi_sv b)
+{
+    bool wa = furi_suffix_is_wildcard(a);
+    bool wb = furi_suffix_is_wildcard(b);
+    if (wa || wb) return (int)wb - (int)wa;
+    return furi_sv_icmp(a, b);
+}
+
+// the labels of a rule (without the '!' of exceptions)
+FURI_INLINE furi_sv furi_suffix_rule_labels(furi_sv rule)
+{
+    if (!furi_sv_is_empty(rule) && *rule.begin == '!') ++rule.begin;
+    return rule;
+}
+
+FURI_INLINE uint32_t furi_suffix_rule_num_labels(furi_sv rule)
+{
+    uint32_t ret = 0;
+    for (furi_host_label_iter hi = furi_make_host_label_iter_begin(furi_suffix_rule_labels(rule));
+        !furi_host_label_iter_is_done(hi); furi_host_label_iter_next(&hi)) ++ret;
+    return ret;
+}
+
+// the label of a rule at depth (0 is the rightmost one)
+FURI_INLINE furi_sv furi_suffix_rule_label(furi_sv rule, uint32_t depth)
+{
+    furi_host_label_iter hi = furi_make_host_label_iter_begin(furi_suffix_rule_labels(rule));
+    for (; depth; --depth) furi_host_label_iter_next(&hi);
+    return furi_host_label_iter_get_value(hi);
+}
+
+// valid rules have:
+//  * non-empty labels of at most 255 chars and no trailing '.'
+//  * "*" only as the whole leftmost label and not in exceptions
+//  * at least two labels if they are exceptions
+FURI_INLINE bool furi_suffix_rule_is_valid(furi_sv rule)
+{
+    furi_sv labels = furi_suffix_rule_labels(rule);
+    bool exception = labels.begin != rule.begin;
+    if (furi_sv_is_empty(labels) || labels.end[-1] == '.') return false;
+
+    uint32_t num_labels = 0;
+    for (furi_host_label_iter hi = furi_make_host_label_iter_begin(labels);
+        !furi_host_label_iter_is_done(hi); furi_host_label_iter_next(&hi))
+    {
+        furi_sv label = furi_host_label_iter_get_value(hi);
+        size_t len = furi_sv_length(label);
+        if (!len || len > UINT8_MAX) return false;
+        ++num_labels;
+        if (furi_suffix_is_wildcard(label))
+        {
+            if (exception || label.begin != labels.begin) return false;
+        }
+        else if (furi_sv_find_first(label, '*'))
+        {
+            return false;
+        }
+    }
+    return !exception || num_labels >= 2;
+}
+
+// orders rules by their labels from right to left, a rule before the rules which extend it
+FURI_INLINE int furi_suffix_rule_cmp(furi_sv a, furi_sv b)
+{
+    furi_host_label_iter ia = furi_make_host_label_iter_begin(furi_suffix_rule_labels(a));
+    furi_host_label_iter ib = furi_make_host_label_iter_begin(furi_suffix_rule_labels(b));
+    for (;; furi_host_label_iter_next(&ia), furi_host_label_iter_next(&ib))
+    {
+        bool da = furi_host_label_iter_is_done(ia);
+        bool db = furi_host_label_iter_is_done(ib);
+        if (da || db) return (int)db - (int)da;
+        int c = furi_suffix_label_cmp(furi_host_label_iter_get_value(ia), furi_host_label_iter_get_value(ib));
+        if (c) return c;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// build
+
+// the number of nodes and label chars the rules need at most
+FURI_INLINE uint32_t furi_suffix_trie_max_nodes(const furi_sv* rules, uint32_t num_rules)
+{
+    uint32_t ret = 1; // root
+    for (uint32_t i = 0; i < num_rules; ++i) ret += furi_suffix_rule_num_labels(rules[i]);
+    return ret;
+}
+
+FURI_INLINE uint32_t furi_suffix_trie_max_chars(const furi_sv* rules, uint32_t num_rules)
+{
+    uint32_t ret = 0;
+    for (uint32_t i = 0; i < num_rules; ++i) ret += (uint32_t)furi_sv_length(rules[i]);
+    return ret;
+}
+
+typedef struct furi_suffix_trie_builder
+{
+    const furi_sv* rules;
+    const uint32_t* order; // rule indices sorted with furi_suffix_rule_cmp
+    furi_suffix_node* nodes;
+    uint32_t node_capacity;
+    uint32_t num_nodes;
+    char* chars;
+    uint32_t char_capacity;
+    uint32_t num_chars;
+} furi_suffix_trie_builder;
+
+FURI_INLINE void furi_suffix_sift_down(const furi_sv* rules, uint32_t* order, uint32_t i, uint32_t n)
+{
+    for (;;)
+    {
+        uint32_t c = 2 * i + 1;
+        if (c >= n) return;
+        if (c + 1 < n && furi_suffix_rule_cmp(rules[order[c]], rules[order[c + 1]]) < 0) ++c;
+        if (furi_suffix_rule_cmp(rules[order[i]], rules[order[c]]) >= 0) return;
+        uint32_t t = order[i];
+        order[i] = order[c];
+        order[c] = t;
+        i = c;
+    }
+}
+
+// heap sort, so that there is no recursion and no need for more scratch space
+FURI_INLINE void furi_suffix_sort_rules(const furi_sv* rules, uint32_t* order, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) order[i] = i;
+    for (uint32_t i = n / 2; i--; ) furi_suffix_sift_down(rules, order, i, n);
+    for (uint32_t i = n; i-- > 1; )
+    {
+        uint32_t t = order[0];
+        order[0] = order[i];
+        order[i] = t;
+        furi_suffix_sift_down(rules, order, 0, i);
+    }
+}
+
+// builds the subtree of node n at depth from the sorted rules [lo, hi) which all share its suffix
+// children are created contiguously before their own subtrees
+FURI_INLINE furi_suffix_build_result furi_suffix_build_node(furi_suffix_trie_builder* b, uint32_t n,
+    uint32_t lo, uint32_t hi, uint32_t depth)
+{
+    // rules which end here sort first
+    for (; lo < hi; ++lo)
+    {
+        furi_sv rule = b->rules[b->order[lo]];
+        if (furi_suffix_rule_num_labels(rule) != depth) break;
+        if (b->nodes[n].rule != FURI_SUFFIX_NONE) return FURI_SUFFIX_DUPLICATE;
+        b->nodes[n].rule = b->order[lo];
+        if (*rule.begin == '!') b->nodes[n].flags |= FURI_SUFFIX_EXCEPTION;
+    }
+
+    uint32_t count = 0;
+    furi_sv prev = FURI_EMPTY_VAL;
+    for (uint32_t i = lo; i < hi; ++i)
+    {
+        furi_sv label = furi_suffix_rule_label(b->rules[b->order[i]], depth);
+        if (!count || furi_suffix_label_cmp(label, prev) != 0) ++count;
+        prev = label;
+    }
+    if (!count) return FURI_SUFFIX_BUILT;
+    if (count > UINT16_MAX) return FURI_SUFFIX_TOO_MANY_CHILDREN;
+    if (b->node_capacity - b->num_nodes < count) return FURI_SUFFIX_OUT_OF_NODES;
+
+    uint32_t c = b->num_nodes;
+    b->nodes[n].children = c;
+    b->nodes[n].num_children = (uint16_t)count;
+    b->num_nodes += count;
+
+    for (uint32_t i = lo; i < hi; ++c)
+    {
+        furi_sv label = furi_suffix_rule_label(b->rules[b->order[i]], depth);
+        uint32_t j = i + 1;
+        while (j < hi && furi_suffix_label_cmp(furi_suffix_rule_label(b->rules[b->order[j]], depth), label) == 0) ++j;
+
+        uint32_t len = (uint32_t)furi_sv_length(label);
+        if (b->char_capacity - b->num_chars < len) return FURI_SUFFIX_OUT_OF_CHARS;
+        furi_suffix_node* child = b->nodes + c;
+        child->label = b->num_chars;
+        child->children = 0;
+        child->rule = FURI_SUFFIX_NONE;
+        child->num_children = 0;
+        child->label_length = (uint8_t)len;
+        child->flags = 0;
+        for (uint32_t k = 0; k < len; ++k) b->chars[b->num_chars++] = furi_ascii_tolower(label.begin[k]);
+        if (furi_suffix_is_wildcard(label)) b->nodes[n].flags |= FURI_SUFFIX_WILDCARD;
+
+        furi_suffix_build_result r = furi_suffix_build_node(b, c, i, j, depth + 1);
+        if (r != FURI_SUFFIX_BUILT) return r;
+        i = j;
+    }
+    return FURI_SUFFIX_BUILT;
+}
+
+// scratch must have room for num_rules indices
+// nodes and chars must have room for furi_suffix_trie_max_nodes and furi_suffix_trie_max_chars
+// (with less the build may fail with FURI_SUFFIX_OUT_OF_NODES or FURI_SUFFIX_OUT_OF_CHARS)
+// the rules are not needed after the build: the labels are copied to chars
+// the matching rules are reported by their index in rules
+FURI_INLINE furi_suffix_build_result furi_build_suffix_trie(const furi_sv* rules, uint32_t num_rules, uint32_t* scratch,
+    furi_suffix_node* nodes, uint32_t node_capacity, char* chars, uint32_t char_capacity, furi_suffix_trie* out)
+{
+    for (uint32_t i = 0; i < num_rules; ++i)
+    {
+        if (!furi_suffix_rule_is_valid(rules[i])) return FURI_SUFFIX_INVALID_RULE;
+    }
+    if (!node_capacity) return FURI_SUFFIX_OUT_OF_NODES;
+
+    furi_suffix_sort_rules(rules, scratch, num_rules);
+    furi_suffix_trie_builder b = {rules, scratch, nodes, node_capacity, 1, chars, char_capacity, 0};
+    furi_suffix_node root = {0, 0, FURI_SUFFIX_NONE, 0, 0, 0};
+    nodes[0] = root;
+
+    furi_suffix_build_result r = furi_suffix_build_node(&b, 0, 0, num_rules, 0);
+    if (r != FURI_SUFFIX_BUILT) return r;
+
+    out->nodes = nodes;
+    out->num_nodes = b.num_nodes;
+    out->chars = chars;
+    out->num_chars = b.num_chars;
+    return FURI_SUFFIX_BUILT;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// match
+
+FURI_INLINE furi_sv furi_suffix_node_label(const furi_suffix_trie* t, const furi_suffix_node* node)
+{
+    const char* begin = t->chars + node->label;
+    return furi_make_sv(begin, begin + node->label_length);
+}
+
+// binary search in the children of a node
+FURI_INLINE const furi_suffix_node* furi_suffix_find_child(const furi_suffix_trie* t, const furi_suffix_node* node, furi_sv label)
+{
+    const furi_suffix_node* lo = t->nodes + node->children;
+    const furi_suffix_node* hi = lo + node->num_children;
+    while (lo < hi)
+    {
+        const furi_suffix_node* mid = lo + (hi - lo) / 2;
+        int c = furi_suffix_label_cmp(label, furi_suffix_node_label(t, mid));
+        if (c == 0) return mid;
+        if (c < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    return NULL;
+}
+
+// host is for example the host of a furi_authority_split
+FURI_INLINE furi_suffix_match furi_suffix_trie_match(const furi_suffix_trie* t, furi_sv host)
+{
+    furi_suffix_match ret = FURI_EMPTY_VAL;
+    ret.rule = FURI_SUFFIX_NONE;
+    if (!t->num_nodes) return ret;
+
+    // the labels where the suffix begins and the one before it
+    furi_host_label_iter hi = furi_make_host_label_iter_begin(host);
+    furi_host_label_iter first = furi_make_host_label_iter_end(host);
+    furi_host_label_iter domain = first;
+    const char* end = hi.end;
+
+    const furi_suffix_node* node = t->nodes;
+    furi_host_label_iter prev = first;
+    for (; !furi_host_label_iter_is_done(hi); prev = hi, furi_host_label_iter_next(&hi))
+    {
+        if (node->flags & FURI_SUFFIX_WILDCARD)
+        {
+            const furi_suffix_node* w = t->nodes + node->children;
+            if (w->rule != FURI_SUFFIX_NONE)
+            {
+                ret.rule = w->rule;
+                first = hi;
+            }
+        }
+
+        const furi_suffix_node* child = furi_suffix_find_child(t, node, furi_host_label_iter_get_value(hi));
+        if (!child) break;
+
+        if (child->flags & FURI_SUFFIX_EXCEPTION)
+        {
+            // the suffix is the one of the rule without this label and there is nothing more to find
+            ret.rule = child->rule;
+            first = prev;
+            domain = hi;
+            break;
+        }
+
+        if (child->rule != FURI_SUFFIX_NONE)
+        {
+            ret.rule = child->rule;
+            first = hi;
+        }
+        node = child;
+    }
+
+    if (ret.rule == FURI_SUFFIX_NONE) return ret;
+    ret.suffix = furi_make_sv(first.begin, end);
+    if (furi_host_label_iter_is_done(domain))
+    {
+        domain = first;
+        furi_host_label_iter_next(&domain);
+    }
+    if (!furi_host_label_iter_is_done(domain)) ret.domain = furi_make_sv(domain.begin, end);
+    return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// blob
+// a header, the nodes, and the chars of a trie
+// numbers are in the byte order of the platform which wrote the blob
+
+#define FURI_SUFFIX_BLOB_MAGIC 0x58465346u // "FSFX"
+#define FURI_SUFFIX_BLOB_VERSION 1
+
+typedef struct furi_suffix_blob_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_nodes;
+    uint32_t num_chars;
+} furi_suffix_blob_header;
+
+FURI_INLINE size_t furi_suffix_trie_blob_size(const furi_suffix_trie* t)
+{
+    return sizeof(furi_suffix_blob_header) + (size_t)t->num_nodes * sizeof(furi_suffix_node) + t->num_chars;
+}
+
+// out must have room for furi_suffix_trie_blob_size bytes
+FURI_INLINE void furi_suffix_trie_write_blob(const furi_suffix_trie* t, void* out)
+{
+    furi_suffix_blob_header h = {FURI_SUFFIX_BLOB_MAGIC, FURI_SUFFIX_BLOB_VERSION, t->num_nodes, t->num_chars};
+    char* o = (char*)out;
+    memcpy(o, &h, sizeof(h));
+    o += sizeof(h);
+    if (t->num_nodes) memcpy(o, t->nodes, t->num_nodes * sizeof(furi_suffix_node));
+    o += t->num_nodes * sizeof(furi_suffix_node);
+    if (t->num_chars) memcpy(o, t->chars, t->num_chars);
+}
+
+// points out into the blob, which must be 4-byte aligned and outlive the trie
+// returns false if the blob is not a valid trie (it's checked, so that matching never reads out of it)
+FURI_INLINE bool furi_suffix_trie_from_blob(const void* blob, size_t size, furi_suffix_trie* out)
+{
+    assert(((uintptr_t)blob & 3) == 0);
+    furi_suffix_blob_header h;
+    if (size < sizeof(h)) return false;
+    memcpy(&h, blob, sizeof(h));
+    if (h.magic != FURI_SUFFIX_BLOB_MAGIC || h.version != FURI_SUFFIX_BLOB_VERSION) return false;
+    if ((size - sizeof(h)) / sizeof(furi_suffix_node) < h.num_nodes) return false;
+    if (size - sizeof(h) - (size_t)h.num_nodes * sizeof(furi_suffix_node) != h.num_chars) return false;
+
+    const furi_suffix_node* nodes = (const furi_suffix_node*)((const char*)blob + sizeof(h));
+    for (uint32_t i = 0; i < h.num_nodes; ++i)
+    {
+        const furi_suffix_node* n = nodes + i;
+        if (n->label > h.num_chars || h.num_chars - n->label < n->label_length) return false;
+        // children come after their parents, so walks always end
+        if (n->num_children && (n->children <= i || n->num_children > h.num_nodes
+            || n->children > h.num_nodes - n->num_children)) return false;
+        if ((n->flags & FURI_SUFFIX_WILDCARD) && !n->num_children) return false;
+    }
+
+    out->nodes = nodes;
+    out->num_nodes = h.num_nodes;
+    out->chars = (const char*)(nodes + h.num_nodes);
+    out->num_chars = h.num_chars;
+    return true;
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,109 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include "suffix.h"
+#include <cstring>
+#include <vector>
+
+namespace furi
+{
+
+struct suffix_match
+{
+    uint32_t rule = FURI_SUFFIX_NONE; // index of the matching rule
+    opt_string_view suffix; // the part of the host matched by the rule
+    opt_string_view domain; // the suffix and the label before it (the registrable domain)
+
+    explicit operator bool() const noexcept { return rule != FURI_SUFFIX_NONE; }
+
+    static suffix_match from_capi(const capi::furi_suffix_match& m) noexcept
+    {
+        return {m.rule, opt_string_view(m.suffix), opt_string_view(m.domain)};
+    }
+};
+
+// host suffix matching (see capi::furi_suffix_trie_match)
+// the trie owns its nodes and labels, so the rules don't need to outlive it
+class suffix_trie
+{
+public:
+    suffix_trie() = default;
+
+    // replaces the rules of the trie
+    // on failure the trie is empty
+    capi::furi_suffix_build_result build(const std::vector<opt_string_view>& rules)
+    {
+        clear();
+        std::vector<capi::furi_sv> svs;
+        svs.reserve(rules.size());
+        for (auto& r : rules) svs.push_back(r.c_sv());
+        auto n = uint32_t(svs.size());
+
+        std::vector<uint32_t> scratch(n);
+        m_nodes.resize(capi::furi_suffix_trie_max_nodes(svs.data(), n));
+        m_chars.resize(capi::furi_suffix_trie_max_chars(svs.data(), n));
+        capi::furi_suffix_trie t;
+        auto result = capi::furi_build_suffix_trie(svs.data(), n, scratch.data(),
+            m_nodes.data(), uint32_t(m_nodes.size()), m_chars.data(), uint32_t(m_chars.size()), &t);
+        if (result != capi::FURI_SUFFIX_BUILT)
+        {
+            clear();
+            return result;
+        }
+        m_nodes.resize(t.num_nodes);
+        m_chars.resize(t.num_chars);
+        return result;
+    }
+
+    // copies a blob made by blob() (or capi::furi_suffix_trie_write_blob)
+    // returns false and leaves the trie empty if it's not valid
+    bool load(const void* blob, size_t size)
+    {
+        clear();
+        // copy to aligned storage first
+        std::vector<capi::furi_suffix_node> aligned(size / sizeof(capi::furi_suffix_node) + 1);
+        std::memcpy(aligned.data(), blob, size);
+        capi::furi_suffix_trie t;
+        if (!capi::furi_suffix_trie_from_blob(aligned.data(), size, &t)) return false;
+        m_nodes.assign(t.nodes, t.nodes + t.num_nodes);
+        m_chars.assign(t.chars, t.chars + t.num_chars);
+        return true;
+    }
+
+    [[nodiscard]] std::vector<char> blob() const
+    {
+        auto t = c_trie();
+        std::vector<char> ret(capi::furi_suffix_trie_blob_size(&t));
+        capi::furi_suffix_trie_write_blob(&t, ret.data());
+        return ret;
+    }
+
+    [[nodiscard]] suffix_match match(opt_string_view host) const noexcept
+    {
+        auto t = c_trie();
+        return suffix_match::from_capi(capi::furi_suffix_trie_match(&t, host.c_sv()));
+    }
+
+    // the number of nodes
+    [[nodiscard]] size_t size() const noexcept { return m_nodes.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_nodes.empty(); }
+
+    void clear() noexcept
+    {
+        m_nodes.clear();
+        m_chars.clear();
+    }
+
+    [[nodiscard]] capi::furi_suffix_trie c_trie() const noexcept
+    {
+        return {m_nodes.data(), uint32_t(m_nodes.size()), m_chars.data(), uint32_t(m_chars.size())};
+    }
+
+private:
+    std::vector<capi::furi_suffix_node> m_nodes;
+    std::vector<char> m_chars;
+};
+
+}
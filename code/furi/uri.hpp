@@ -0,0 +1,238 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#pragma once
+#include "furi.hpp"
+#include <memory_resource>
+#include <cstring>
+
+namespace furi
+{
+
+// an owning uri: a zero-terminated text and the offsets of its components (capi::furi_uri_split_compact)
+// texts shorter than inline_capacity are stored in the object and longer ones in a single allocation
+// the accessors build views into the text on demand, so copies and moves need no fixups:
+// copies are a memcpy of the text (and an allocation if it's long), moves with the same resource never allocate
+// allocators follow the std::pmr rules: copies use the default resource unless one is given,
+// moves keep the resource of the source, and assignments keep the resource of the target
+// uris must be shorter than 4 GB
+class uri
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    // including the terminating zero (this makes the object 128 bytes on 64-bit targets)
+    static constexpr size_t inline_capacity = 88;
+
+    uri() noexcept : uri(allocator_type{}) {}
+
+    explicit uri(const allocator_type& alloc) noexcept
+        : m_alloc(alloc)
+    {
+        reset();
+    }
+
+    explicit uri(opt_string_view str, const allocator_type& alloc = {})
+        : m_alloc(alloc)
+    {
+        reset();
+        assign(str);
+    }
+
+    uri(const uri& other) : uri(other, allocator_type{}) {}
+
+    uri(const uri& other, const allocator_type& alloc)
+        : m_alloc(alloc)
+    {
+        reset();
+        copy_from(other);
+    }
+
+    uri(uri&& other) noexcept
+        : m_alloc(other.m_alloc)
+    {
+        reset();
+        steal_from(other);
+    }
+
+    uri(uri&& other, const allocator_type& alloc)
+        : m_alloc(alloc)
+    {
+        reset();
+        if (m_alloc == other.m_alloc) steal_from(other);
+        else copy_from(other);
+    }
+
+    uri& operator=(const uri& other)
+    {
+        if (this != &other) copy_from(other);
+        return *this;
+    }
+
+    // takes the text of other if the resources are equal
+    // otherwise it's a copy into the resource of this uri, so it may allocate and isn't noexcept
+    // (the move constructor always keeps the resource and is noexcept, so containers move when they grow)
+    uri& operator=(uri&& other)
+    {
+        if (this == &other) return *this;
+        if (m_alloc == other.m_alloc)
+        {
+            free_heap();
+            steal_from(other);
+        }
+        else
+        {
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    ~uri() { free_heap(); }
+
+    // replaces the text and splits it
+    // str may be a part of this uri
+    void assign(opt_string_view str)
+    {
+        set_text(str.data(), str.size());
+        m_split = capi::furi_split_uri_compact(capi::furi_make_sv(data(), data() + str.size()));
+        if (str.null()) m_split.flags = 0; // all components of a null uri are null
+    }
+
+    uri& operator=(opt_string_view str)
+    {
+        assign(str);
+        return *this;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    [[nodiscard]] size_t size() const noexcept { return m_split.length; }
+    [[nodiscard]] bool empty() const noexcept { return m_split.length == 0; }
+    [[nodiscard]] bool is_inline() const noexcept { return !m_on_heap; }
+
+    [[nodiscard]] const char* c_str() const noexcept { return data(); }
+    [[nodiscard]] opt_string_view str() const noexcept { return opt_string_view(data(), data() + size()); }
+    operator opt_string_view() const noexcept { return str(); }
+
+    [[nodiscard]] opt_string_view scheme() const noexcept { return get(capi::FURI_URI_SCHEME); }
+    [[nodiscard]] opt_string_view authority() const noexcept { return get(capi::FURI_URI_AUTHORITY); }
+    [[nodiscard]] opt_string_view path() const noexcept { return get(capi::FURI_URI_PATH); }
+    [[nodiscard]] opt_string_view query() const noexcept { return get(capi::FURI_URI_QUERY); }
+    [[nodiscard]] opt_string_view fragment() const noexcept { return get(capi::FURI_URI_FRAGMENT); }
+    [[nodiscard]] opt_string_view req_path() const noexcept { return get(capi::FURI_URI_REQ_PATH); }
+
+    // views into this uri, valid until it's modified or destroyed
+    [[nodiscard]] uri_split split() const noexcept
+    {
+        return uri_split::from_capi(capi::furi_uri_split_from_compact(&m_split, data()));
+    }
+
+    [[nodiscard]] const capi::furi_uri_split_compact& compact_split() const noexcept { return m_split; }
+
+    bool operator==(const uri& other) const noexcept { return str() == other.str(); }
+    bool operator!=(const uri& other) const noexcept { return str() != other.str(); }
+    bool operator<(const uri& other) const noexcept { return str() < other.str(); }
+
+private:
+    struct heap_buf
+    {
+        char* data;
+        size_t capacity;
+    };
+
+    allocator_type m_alloc;
+    capi::furi_uri_split_compact m_split;
+    bool m_on_heap;
+    union
+    {
+        char m_inline[inline_capacity];
+        heap_buf m_heap;
+    };
+
+    const char* data() const noexcept { return m_on_heap ? m_heap.data : m_inline; }
+
+    opt_string_view get(capi::furi_uri_component c) const noexcept
+    {
+        return opt_string_view(capi::furi_uri_split_compact_get(&m_split, data(), c));
+    }
+
+    // an empty inline text (doesn't free)
+    void reset() noexcept
+    {
+        m_on_heap = false;
+        m_inline[0] = 0;
+        m_split = capi::furi_split_uri_compact(capi::furi_make_sv(m_inline, m_inline));
+    }
+
+    void free_heap() noexcept
+    {
+        if (!m_on_heap) return;
+        m_alloc.deallocate(m_heap.data, m_heap.capacity);
+        m_on_heap = false;
+    }
+
+    // copies a text of length len and its terminating zero into the inline buffer if it fits,
+    // or the heap buffer if it fits, or a new heap buffer
+    // src may point into the current text
+    void set_text(const char* src, size_t len)
+    {
+        assert(len < UINT32_MAX);
+        if (len < inline_capacity)
+        {
+            heap_buf old = m_on_heap ? m_heap : heap_buf{nullptr, 0};
+            if (len) memmove(m_inline, src, len);
+            m_inline[len] = 0;
+            m_on_heap = false;
+            if (old.data) m_alloc.deallocate(old.data, old.capacity);
+        }
+        else if (m_on_heap && m_heap.capacity > len)
+        {
+            memmove(m_heap.data, src, len);
+            m_heap.data[len] = 0;
+        }
+        else
+        {
+            char* buf = m_alloc.allocate(len + 1);
+            memcpy(buf, src, len);
+            buf[len] = 0;
+            free_heap();
+            m_heap = {buf, len + 1};
+            m_on_heap = true;
+        }
+    }
+
+    void copy_from(const uri& other)
+    {
+        set_text(other.data(), other.size());
+        m_split = other.m_split;
+    }
+
+    // this must have no heap buffer and the same allocator as other
+    void steal_from(uri& other) noexcept
+    {
+        if (other.m_on_heap)
+        {
+            m_heap.data = other.m_heap.data;
+            m_heap.capacity = other.m_heap.capacity;
+            m_on_heap = true;
+        }
+        else
+        {
+            memcpy(m_inline, other.m_inline, other.size() + 1);
+            m_on_heap = false;
+        }
+        m_split = other.m_split;
+        other.reset();
+    }
+};
+
+}
+
+namespace std
+{
+template <>
+struct hash<furi::uri>
+{
+    size_t operator()(const furi::uri& u) const noexcept { return hash<string_view>{}(u.str()); }
+};
+}
@@ -16,19 +16,22 @@ void print_elem(const char* title, furi_sv sv) {
 
 void decompose(const char* uri) {
     puts(uri);
-    furi_uri_split split = furi_split_uri(furi_make_sv_from_string(uri));
+    furi_uri_decomposition d = furi_decompose_uri(furi_make_sv_from_string(uri));
 
-    print_elem("scheme   ", split.scheme);
-    print_elem("authority", split.authority);
-    if (!furi_sv_is_empty(split.authority)) {
-        furi_authority_split asplit = furi_split_authority(split.authority);
-        print_elem("  userinfo", asplit.userinfo);
-        print_elem("  host    ", asplit.host);
-        print_elem("  port    ", asplit.port);
+    print_elem("scheme   ", d.uri.scheme);
+    print_elem("authority", d.uri.authority);
+    if (!furi_sv_is_empty(d.uri.authority)) {
+        print_elem("  userinfo", d.authority.userinfo);
+        if (!furi_sv_is_null(d.authority.userinfo)) {
+            print_elem("    username", d.userinfo.username);
+            print_elem("    password", d.userinfo.password);
+        }
+        print_elem("  host    ", d.authority.host);
+        print_elem("  port    ", d.authority.port);
     }
-    print_elem("path     ", split.path);
-    print_elem("query    ", split.query);
-    print_elem("fragment ", split.fragment);
+    print_elem("path     ", d.uri.path);
+    print_elem("query    ", d.uri.query);
+    print_elem("fragment ", d.uri.fragment);
 }
 
 int main(int argc, char* argv[]) {
@@ -11,6 +11,7 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     const char* sdata = (const char*)data;
     furi_sv in = furi_make_sv(sdata, sdata + size);
     furi_uri_split s = furi_split_uri(in);
-    (void)s;
+    furi_uri_split ref = furi_split_uri_scalar(in);
+    if (memcmp(&s, &ref, sizeof(s)) != 0) __builtin_trap(); // engines must agree
     return 0;
 }
@@ -0,0 +1,320 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/build.h>
+#include <furi/resolve.h> // furi_split_reference
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+#define TEST_ASSERT_NULL_SV(sv) TEST_ASSERT_TRUE(furi_sv_is_null(sv))
+
+static char buf[1024];
+
+static furi_sv sv(const char* str)
+{
+    return furi_make_sv_from_string(str);
+}
+
+// builds to buf, checking the length and returning the split
+static furi_uri_split build(const furi_uri_parts* p, bool encode)
+{
+    size_t len = furi_build_uri_length(p, encode);
+    TEST_ASSERT_LESS_THAN(sizeof(buf), len);
+    memset(buf, '!', sizeof(buf));
+    furi_uri_split s = furi_build_uri(p, buf, encode);
+    TEST_ASSERT_EQUAL_PTR(buf + len, s.req_path.end);
+    TEST_ASSERT_EQUAL('!', buf[len]);
+    return s;
+}
+
+static furi_sv built(furi_uri_split s)
+{
+    return furi_make_sv(buf, s.req_path.end);
+}
+
+void pct_encode(void)
+{
+    char out[64];
+    furi_sv in = sv("a b/c%d?e");
+    TEST_ASSERT_EQUAL(15, furi_pct_encoded_length(in, FURI_CC_PATH));
+    char* end = furi_pct_encode(in, out, FURI_CC_PATH);
+    TEST_ASSERT_EXPECT_SV("a%20b/c%25d%3Fe", furi_make_sv(out, end));
+
+    end = furi_pct_encode(in, out, FURI_CC_QUERY);
+    TEST_ASSERT_EXPECT_SV("a%20b/c%25d?e", furi_make_sv(out, end));
+
+    in = sv("\xC3\xA9&x=y+z");
+    TEST_ASSERT_EQUAL(18, furi_pct_encoded_length(in, FURI_CC_UNRESERVED));
+    end = furi_pct_encode(in, out, FURI_CC_UNRESERVED);
+    TEST_ASSERT_EXPECT_SV("%C3%A9%26x%3Dy%2Bz", furi_make_sv(out, end));
+
+    in = sv("nothing-to_encode.~");
+    TEST_ASSERT_EQUAL(furi_sv_length(in), furi_pct_encoded_length(in, FURI_CC_UNRESERVED));
+    end = furi_pct_encode(in, out, FURI_CC_UNRESERVED);
+    TEST_ASSERT_SV_EQUAL(in, furi_make_sv(out, end));
+
+    TEST_ASSERT_EQUAL(0, furi_pct_encoded_length(FURI_EMPTY_T(furi_sv), FURI_CC_PATH));
+    TEST_ASSERT_EQUAL_PTR(out, furi_pct_encode(FURI_EMPTY_T(furi_sv), out, FURI_CC_PATH));
+}
+
+void build_raw(void)
+{
+    furi_uri_parts p = FURI_EMPTY_VAL;
+    p.scheme = sv("http");
+    p.authority = sv("user@x.com:43");
+    p.path = sv("/a/b");
+    p.query = sv("x=1");
+    p.fragment = sv("top");
+    furi_uri_split s = build(&p, false);
+    TEST_ASSERT_EXPECT_SV("http://user@x.com:43/a/b?x=1#top", built(s));
+    TEST_ASSERT_EXPECT_SV("http", s.scheme);
+    TEST_ASSERT_EXPECT_SV("user@x.com:43", s.authority);
+    TEST_ASSERT_EXPECT_SV("/a/b", s.path);
+    TEST_ASSERT_EXPECT_SV("x=1", s.query);
+    TEST_ASSERT_EXPECT_SV("top", s.fragment);
+    TEST_ASSERT_EXPECT_SV("/a/b?x=1#top", s.req_path);
+
+    // authority parts
+    p.authority = FURI_EMPTY_T(furi_sv);
+    p.userinfo = sv("me:pass");
+    p.host = sv("[::1]");
+    p.port = sv("8080");
+    p.path = sv("rel");
+    p.query = FURI_EMPTY_T(furi_sv);
+    p.fragment = sv("");
+    s = build(&p, false);
+    TEST_ASSERT_EXPECT_SV("http://me:pass@[::1]:8080/rel#", built(s));
+    TEST_ASSERT_EXPECT_SV("me:pass@[::1]:8080", s.authority);
+    TEST_ASSERT_EXPECT_SV("/rel", s.path);
+    TEST_ASSERT_NULL_SV(s.query);
+    TEST_ASSERT_EXPECT_SV("", s.fragment);
+
+    // nothing but the host
+    furi_uri_parts h = FURI_EMPTY_VAL;
+    h.host = sv("");
+    s = build(&h, false);
+    TEST_ASSERT_EXPECT_SV("//", built(s));
+    TEST_ASSERT_EXPECT_SV("", s.authority);
+    TEST_ASSERT_EXPECT_SV("", s.path);
+
+    // empty
+    furi_uri_parts e = FURI_EMPTY_VAL;
+    s = build(&e, false);
+    TEST_ASSERT_EQUAL(0, furi_sv_length(built(s)));
+    TEST_ASSERT_NULL_SV(s.scheme);
+    TEST_ASSERT_NULL_SV(s.authority);
+    TEST_ASSERT_EXPECT_SV("", s.path);
+
+    e.scheme = sv("mailto");
+    e.path = sv("me@x.com");
+    s = build(&e, false);
+    TEST_ASSERT_EXPECT_SV("mailto:me@x.com", built(s));
+    TEST_ASSERT_NULL_SV(s.authority);
+}
+
+void build_query_items(void)
+{
+    furi_query_iter_value items[3] = {
+        {sv("a"), sv("1")},
+        {sv("flag"), FURI_EMPTY_VAL},
+        {sv("e"), sv("")},
+    };
+
+    furi_uri_parts p = FURI_EMPTY_VAL;
+    p.path = sv("/p");
+    p.query_items = items;
+    p.num_query_items = 3;
+    furi_uri_split s = build(&p, false);
+    TEST_ASSERT_EXPECT_SV("/p?a=1&flag&e=", built(s));
+    TEST_ASSERT_EXPECT_SV("a=1&flag&e=", s.query);
+
+    p.query = sv("");
+    s = build(&p, false);
+    TEST_ASSERT_EXPECT_SV("/p?a=1&flag&e=", built(s));
+
+    p.query = sv("x=y");
+    s = build(&p, false);
+    TEST_ASSERT_EXPECT_SV("/p?x=y&a=1&flag&e=", built(s));
+
+    items[0].key = sv("");
+    items[0].value = FURI_EMPTY_T(furi_sv);
+    p.query = FURI_EMPTY_T(furi_sv);
+    s = build(&p, false);
+    TEST_ASSERT_EXPECT_SV("/p?&flag&e=", built(s));
+}
+
+void build_encoded(void)
+{
+    furi_query_iter_value items[2] = {
+        {sv("q"), sv("a&b=c d")},
+        {sv("r/s"), sv("\xC3\xA9")},
+    };
+
+    furi_uri_parts p = FURI_EMPTY_VAL;
+    p.scheme = sv("https");
+    p.userinfo = sv("a b@c");
+    p.host = sv("ex ample.com");
+    p.port = sv("443");
+    p.path = sv("/x y/%z?");
+    p.query = sv("k=v#");
+    p.query_items = items;
+    p.num_query_items = 2;
+    p.fragment = sv("f g#");
+    furi_uri_split s = build(&p, true);
+    TEST_ASSERT_EXPECT_SV("https://a%20b%40c@ex%20ample.com:443/x%20y/%25z%3F?k=v%23&q=a%26b%3Dc%20d&r%2Fs=%C3%A9#f%20g%23", built(s));
+    TEST_ASSERT_EXPECT_SV("a%20b%40c@ex%20ample.com:443", s.authority);
+    TEST_ASSERT_EXPECT_SV("/x%20y/%25z%3F", s.path);
+    TEST_ASSERT_EXPECT_SV("f%20g%23", s.fragment);
+
+    // ip literals and whole authorities are written as they are
+    p.host = sv("[::1]");
+    p.userinfo = FURI_EMPTY_T(furi_sv);
+    p.num_query_items = 0;
+    s = build(&p, true);
+    TEST_ASSERT_EXPECT_SV("https://[::1]:443/x%20y/%25z%3F?k=v%23#f%20g%23", built(s));
+
+    p.authority = sv("a b");
+    s = build(&p, true);
+    TEST_ASSERT_EXPECT_SV("a b", s.authority);
+}
+
+// encoded builds are split back to the same components
+void round_trip(void)
+{
+    static const char chars[] = "a:/?#@% &=";
+    char text[5][8];
+    furi_sv comp[5];
+    uint32_t seed = 1;
+    for (int iter = 0; iter < 20000; ++iter)
+    {
+        for (int c = 0; c < 5; ++c)
+        {
+            seed = seed * 1103515245 + 12345;
+            int len = (seed >> 16) % 7;
+            for (int i = 0; i < len; ++i)
+            {
+                seed = seed * 1103515245 + 12345;
+                text[c][i] = chars[(seed >> 16) % (sizeof(chars) - 1)];
+            }
+            comp[c] = (seed >> 8) % 5 ? furi_make_sv(text[c], text[c] + len) : FURI_EMPTY_T(furi_sv);
+        }
+
+        furi_uri_parts p = FURI_EMPTY_VAL;
+        p.scheme = comp[0].begin ? sv("s") : FURI_EMPTY_T(furi_sv);
+        p.host = comp[1];
+        p.path = comp[2];
+        p.query = comp[3];
+        p.fragment = comp[4];
+        if (!p.host.begin)
+        {
+            // the ambiguous relative paths
+            if (furi_sv_starts_with(p.path, "//")) continue;
+            const char* colon = furi_sv_find_first(p.path, ':');
+            const char* slash = furi_sv_find_first(p.path, '/');
+            if (!p.scheme.begin && colon && (!slash || colon < slash)) continue;
+        }
+
+        furi_uri_split s = build(&p, true);
+        furi_uri_split r = furi_split_reference(built(s));
+        TEST_ASSERT_TRUE(r.scheme.begin == s.scheme.begin && r.scheme.end == s.scheme.end);
+        TEST_ASSERT_TRUE(r.authority.begin == s.authority.begin && r.authority.end == s.authority.end);
+        TEST_ASSERT_TRUE(r.path.begin == s.path.begin && r.path.end == s.path.end);
+        TEST_ASSERT_TRUE(r.query.begin == s.query.begin && r.query.end == s.query.end);
+        TEST_ASSERT_TRUE(r.fragment.begin == s.fragment.begin && r.fragment.end == s.fragment.end);
+
+        char dec[32];
+        if (p.host.begin) TEST_ASSERT_SV_EQUAL(p.host, furi_pct_decode(s.authority, dec, false));
+        if (p.query.begin) TEST_ASSERT_SV_EQUAL(p.query, furi_pct_decode(s.query, dec, false));
+        if (p.fragment.begin) TEST_ASSERT_SV_EQUAL(p.fragment, furi_pct_decode(s.fragment, dec, false));
+    }
+}
+
+static bool remove_utm(void* user_data, furi_query_iter_value item)
+{
+    (void)user_data;
+    return furi_sv_starts_with(item.key, "utm_");
+}
+
+static furi_sv edit(const char* query, const furi_query_edit* e)
+{
+    furi_sv q = sv(query);
+    TEST_ASSERT_LESS_THAN(sizeof(buf), furi_query_edit_max_length(q, e));
+    return furi_query_edit_apply(q, e, buf);
+}
+
+void query_edit(void)
+{
+    furi_sv remove[2] = {sv("fbclid"), sv("gclid")};
+    furi_query_edit e = FURI_EMPTY_VAL;
+    e.remove_keys = remove;
+    e.num_remove_keys = 2;
+    e.remove_if = remove_utm;
+
+    furi_sv r = edit("a=1&utm_source=x&b=2&fbclid=abc&utm_medium=y", &e);
+    TEST_ASSERT_EXPECT_SV("a=1&b=2", r);
+    TEST_ASSERT_EQUAL_PTR(buf, r.begin);
+
+    r = edit("fbclid=1&gclid=2", &e);
+    TEST_ASSERT_EXPECT_SV("", r);
+
+    r = edit("gclid=2&a&&b=", &e);
+    TEST_ASSERT_EXPECT_SV("a&&b=", r);
+
+    // nothing to do: the query is returned as it is
+    const char* q = "a=1&fbclid2=x&utm=3";
+    r = edit(q, &e);
+    TEST_ASSERT_EQUAL_PTR(q, r.begin);
+    TEST_ASSERT_EXPECT_SV(q, r);
+    TEST_ASSERT_TRUE(furi_sv_is_null(furi_query_edit_apply(FURI_EMPTY_T(furi_sv), &e, buf)));
+
+    furi_query_iter_value set[2] = {
+        {sv("token"), sv("secret")},
+        {sv("v"), FURI_EMPTY_VAL},
+    };
+    furi_query_iter_value append[1] = {
+        {sv("x"), sv("1")},
+    };
+    e.set = set;
+    e.num_set = 2;
+    r = edit("a=1&token=old&b=2&token=older&v", &e);
+    TEST_ASSERT_EXPECT_SV("a=1&token=secret&b=2&v", r);
+
+    r = edit("fbclid=1&v&token=secret", &e);
+    TEST_ASSERT_EXPECT_SV("v&token=secret", r);
+
+    r = edit("a=1", &e);
+    TEST_ASSERT_EXPECT_SV("a=1&token=secret&v", r);
+
+    // already set
+    q = "v&token=secret&a=1";
+    r = edit(q, &e);
+    TEST_ASSERT_EQUAL_PTR(q, r.begin);
+
+    e.append = append;
+    e.num_append = 1;
+    r = edit(q, &e);
+    TEST_ASSERT_EXPECT_SV("v&token=secret&a=1&x=1", r);
+
+    r = edit("", &e);
+    TEST_ASSERT_EXPECT_SV("token=secret&v&x=1", r);
+
+    r = edit("utm_a=1&token=", &e);
+    TEST_ASSERT_EXPECT_SV("token=secret&v&x=1", r);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(pct_encode);
+    RUN_TEST(build_raw);
+    RUN_TEST(build_query_items);
+    RUN_TEST(build_encoded);
+    RUN_TEST(round_trip);
+    RUN_TEST(query_edit);
+    return UNITY_END();
+}
@@ -0,0 +1,80 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/build.hpp>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-build");
+
+TEST_CASE("pct_encode")
+{
+    CHECK(pct_encode("a b/c", capi::FURI_CC_PATH) == "a%20b/c");
+    CHECK(pct_encode("a b/c", capi::FURI_CC_UNRESERVED) == "a%20b%2Fc");
+    CHECK(pct_encode({}, capi::FURI_CC_PATH).empty());
+
+    std::string out = "x=";
+    pct_encode("1&2", capi::FURI_CC_UNRESERVED, out);
+    CHECK(out == "x=1%262");
+}
+
+TEST_CASE("uri_builder")
+{
+    uri_builder b;
+    b.scheme("https").host("example.com").port("8443").path("/search");
+    b.add_query_item("q", "furi uri").add_query_item("exact");
+    CHECK(b.build() == "https://example.com:8443/search?q=furi uri&exact");
+
+    b.encode();
+    CHECK(b.length() == 50);
+    std::string out = "Location: ";
+    auto s = b.build(out);
+    CHECK(out == "Location: https://example.com:8443/search?q=furi%20uri&exact");
+    CHECK(s.authority == "example.com:8443");
+    CHECK(s.query == "q=furi%20uri&exact");
+    CHECK(s.authority.data() == out.data() + 18);
+
+    // from the split of another uri
+    auto src = uri_split::from_uri("http://user@x.com/a/b?c=d#e");
+    CHECK(uri_builder(src).build() == "http://user@x.com/a/b?c=d#e");
+    CHECK(uri_builder(src).fragment({}).add_query_item("f", "g").build() == "http://user@x.com/a/b?c=d&f=g");
+    CHECK(uri_builder(src).authority({}).host("y.com").path("z").build() == "http://y.com/z?c=d#e");
+}
+
+TEST_CASE("query_editor")
+{
+    auto is_tracking = [](opt_string_view key, opt_string_view) {
+        return key.substr(0, 4) == "utm_";
+    };
+    query_editor e;
+    e.remove("fbclid").remove_if(is_tracking).set("token", "abc").append("via", "gw");
+
+    std::string buf;
+    auto q = e.apply("a=1&utm_source=x&token=old&fbclid=2&b", buf);
+    CHECK(q == "a=1&token=abc&b&via=gw");
+    CHECK(q.data() == buf.data());
+
+    CHECK(e.apply("") == "token=abc&via=gw");
+
+    query_editor strip;
+    strip.remove_if(is_tracking);
+    std::string_view clean = "a=1&b=2";
+    q = strip.apply(clean, buf);
+    CHECK(q.data() == clean.data());
+    CHECK(strip.apply("utm_a&a=1&utm_b") == "a=1");
+
+    // as part of a rebuilt uri
+    auto s = uri_split::from_uri("https://x.com/p?utm_medium=m&id=7#f");
+    CHECK(uri_builder(s).query(strip.apply(s.query, buf)).build() == "https://x.com/p?id=7#f");
+
+    // the predicate is owned by the editor, so temporaries and copies are fine
+    query_editor owned;
+    owned.remove_if([prefix = std::string("tmp_")](opt_string_view key, opt_string_view) {
+        return key.substr(0, prefix.size()) == prefix;
+    });
+    auto copy = owned;
+    owned = query_editor();
+    CHECK(copy.apply("tmp_a=1&b=2&tmp_c") == "b=2");
+    CHECK(owned.apply("tmp_a=1&b=2") == "tmp_a=1&b=2");
+}
@@ -0,0 +1,140 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/cache.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+
+static char buf[1024];
+static furi_query_iter_value scratch[8];
+
+static bool hash_equal(furi_hash128 a, furi_hash128 b)
+{
+    return a.lo == b.lo && a.hi == b.hi;
+}
+
+// writes the key to buf and checks that the hash matches it
+static furi_sv key(const furi_cache_key_config* c, const char* uri)
+{
+    furi_sv u = furi_make_sv_from_string(uri);
+    char* end = furi_cache_key_write(c, u, scratch, 8, buf);
+    TEST_ASSERT_NOT_NULL(end);
+    TEST_ASSERT_TRUE(end - buf <= (ptrdiff_t)furi_sv_length(u));
+
+    furi_hash128 h;
+    TEST_ASSERT_TRUE(furi_cache_key_hash(c, u, scratch, 8, 5, &h));
+    TEST_ASSERT_TRUE(hash_equal(furi_hash(furi_make_sv(buf, end), 5), h));
+    return furi_make_sv(buf, end);
+}
+
+void hash(void)
+{
+    const char* text = "the quick brown fox jumps over the lazy dog";
+    furi_sv all = furi_make_sv_from_string(text);
+    furi_hash128 h = furi_hash(all, 0);
+
+    // any slicing gives the same hash
+    for (size_t a = 0; a <= 43; ++a)
+    {
+        for (size_t b = a; b <= 43; b += 3)
+        {
+            furi_hash_state st = furi_make_hash_state(0);
+            furi_hash_feed(&st, furi_make_sv(text, text + a));
+            furi_hash_feed(&st, furi_make_sv(text + a, text + b));
+            furi_hash_feed(&st, furi_make_sv(text + b, text + 43));
+            TEST_ASSERT_TRUE(hash_equal(h, furi_hash_finish(&st)));
+        }
+    }
+
+    TEST_ASSERT_FALSE(hash_equal(h, furi_hash(all, 1)));
+    TEST_ASSERT_FALSE(hash_equal(h, furi_hash(furi_make_sv(text, text + 42), 0)));
+    TEST_ASSERT_FALSE(hash_equal(furi_hash(furi_make_sv(text, text), 0), furi_hash(furi_make_sv("\0", "\0" + 1), 0)));
+    TEST_ASSERT_FALSE(hash_equal(furi_hash(furi_make_sv(text, text + 1), 0), furi_hash(furi_make_sv(text, text + 2), 0)));
+}
+
+void components(void)
+{
+    furi_cache_key_config c = FURI_EMPTY_VAL;
+    c.components = FURI_URI_SCHEME | FURI_URI_AUTHORITY | FURI_URI_PATH | FURI_URI_QUERY | FURI_URI_FRAGMENT;
+    TEST_ASSERT_EXPECT_SV("http://x.com/a?b=1&c#d", key(&c, "http://x.com/a?b=1&c#d"));
+    TEST_ASSERT_EXPECT_SV("http://x.com/a?b=1&c#d", key(&c, "http://x.com/a?&b=1&&c&#d"));
+    TEST_ASSERT_EXPECT_SV("http://x.com/a#d", key(&c, "http://x.com/a?#d"));
+    TEST_ASSERT_EXPECT_SV("http://x.com/a?=", key(&c, "http://x.com/a?="));
+
+    c.components = FURI_URI_PATH | FURI_URI_QUERY;
+    TEST_ASSERT_EXPECT_SV("/a?b=1", key(&c, "http://x.com/a?b=1#d"));
+    TEST_ASSERT_EXPECT_SV("", key(&c, "http://x.com"));
+
+    c.components = FURI_URI_AUTHORITY | FURI_URI_PATH;
+    TEST_ASSERT_EXPECT_SV("//x.com/a", key(&c, "https://x.com/a?b=1#d"));
+}
+
+void query_filters(void)
+{
+    furi_sv keys[2] = {furi_make_sv_from_string("utm"), furi_make_sv_from_string("id")};
+    furi_cache_key_config c = FURI_EMPTY_VAL;
+    c.components = FURI_URI_PATH | FURI_URI_QUERY;
+    c.keys = keys;
+    c.num_keys = 2;
+
+    c.filter = FURI_CACHE_KEY_DENY;
+    TEST_ASSERT_EXPECT_SV("/p?a=1&ids=3", key(&c, "/p?utm=x&a=1&id=2&ids=3"));
+    TEST_ASSERT_EXPECT_SV("/p", key(&c, "/p?utm=x&id"));
+
+    c.filter = FURI_CACHE_KEY_ALLOW;
+    TEST_ASSERT_EXPECT_SV("/p?utm=x&id=2", key(&c, "/p?utm=x&a=1&id=2&ids=3"));
+    TEST_ASSERT_EXPECT_SV("/p", key(&c, "/p?a=1"));
+
+    c.sort_query = true;
+    TEST_ASSERT_EXPECT_SV("/p?id=2&utm=x", key(&c, "/p?utm=x&a=1&id=2&ids=3"));
+}
+
+void sorting(void)
+{
+    furi_cache_key_config c = FURI_EMPTY_VAL;
+    c.components = FURI_URI_PATH | FURI_URI_QUERY;
+    c.sort_query = true;
+    TEST_ASSERT_EXPECT_SV("/?a=1&b=2", key(&c, "/?b=2&a=1"));
+    TEST_ASSERT_EXPECT_SV("/?a&a=&a=1&a=2&b", key(&c, "/?a=2&b&a=&a=1&a"));
+    TEST_ASSERT_EXPECT_SV("/?=&a", key(&c, "/?a&="));
+
+    // the order doesn't matter for the hash either
+    furi_hash128 h1, h2;
+    TEST_ASSERT_TRUE(furi_cache_key_hash(&c, furi_make_sv_from_string("/?x=1&y=2&z"), scratch, 8, 0, &h1));
+    TEST_ASSERT_TRUE(furi_cache_key_hash(&c, furi_make_sv_from_string("/?z&y=2&x=1"), scratch, 8, 0, &h2));
+    TEST_ASSERT_TRUE(hash_equal(h1, h2));
+    c.sort_query = false;
+    TEST_ASSERT_TRUE(furi_cache_key_hash(&c, furi_make_sv_from_string("/?z&y=2&x=1"), scratch, 8, 0, &h2));
+    TEST_ASSERT_FALSE(hash_equal(h1, h2));
+
+    // more items than scratch
+    c.sort_query = true;
+    furi_sv u = furi_make_sv_from_string("/?a&b&c&d&e&f&g&h&i");
+    TEST_ASSERT_NULL(furi_cache_key_write(&c, u, scratch, 8, buf));
+    TEST_ASSERT_FALSE(furi_cache_key_hash(&c, u, scratch, 8, 0, &h1));
+
+    // empty items don't take space
+    TEST_ASSERT_EXPECT_SV("/?a&b&c&d&e&f&g&h", key(&c, "/?h&&g&f&&e&d&c&b&a&&"));
+
+    // more than 16 items are sorted with qsort
+    static furi_query_iter_value big[32];
+    u = furi_make_sv_from_string("/?t&s&r&q&p&o&n&m&l&k&j&i&h&g&f&e&d&c&b&a");
+    char* end = furi_cache_key_write(&c, u, big, 32, buf);
+    TEST_ASSERT_EXPECT_SV("/?a&b&c&d&e&f&g&h&i&j&k&l&m&n&o&p&q&r&s&t", furi_make_sv(buf, end));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(hash);
+    RUN_TEST(components);
+    RUN_TEST(query_filters);
+    RUN_TEST(sorting);
+    return UNITY_END();
+}
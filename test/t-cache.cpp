@@ -0,0 +1,50 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/cache.hpp>
+#include <unordered_set>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-cache");
+
+TEST_CASE("cache_key_generator")
+{
+    cache_key_generator gen;
+    gen.deny("utm_source").deny("fbclid").sort_query();
+
+    CHECK(gen.key("https://x.com/a?b=2&a=1#frag") == "https://x.com/a?a=1&b=2");
+    CHECK(gen.key("https://x.com/a?utm_source=mail&a=1&b=2&fbclid=7") == "https://x.com/a?a=1&b=2");
+
+    CHECK(gen.hash("https://x.com/a?b=2&a=1") == gen.hash("https://x.com/a?a=1&b=2&fbclid=3"));
+    CHECK(gen.hash64("https://x.com/a?b=2&a=1") != gen.hash64("https://x.com/a?b=2&a=2"));
+    CHECK(gen.hash("https://x.com/a?b=2&a=1", 7) == hash_str("https://x.com/a?a=1&b=2", 7));
+
+    std::string out = "key:";
+    gen.key("http://y.com/?z&y", out);
+    CHECK(out == "key:http://y.com/?y&z");
+
+    // more items than the inline scratch space
+    std::string q = "/?";
+    std::string sorted = "/?";
+    for (int i = 99; i >= 0; --i) q += "k" + std::to_string(1000 + i) + "&";
+    for (int i = 0; i < 100; ++i) sorted += (i ? "&k" : "k") + std::to_string(1000 + i);
+    CHECK(gen.key(q) == sorted);
+    CHECK(gen.hash(q) == hash_str(sorted));
+}
+
+TEST_CASE("cache_key_generator allow")
+{
+    cache_key_generator gen(capi::FURI_URI_PATH | capi::FURI_URI_QUERY);
+    gen.allow("page").allow("q");
+    std::unordered_set<uint64_t> keys;
+    keys.insert(gen.hash64("http://a.com/search?q=furi&page=2&session=1"));
+    keys.insert(gen.hash64("http://b.com/search?session=2&page=2&q=furi"));
+    CHECK(keys.size() == 2); // not sorted
+    gen.sort_query();
+    keys.clear();
+    keys.insert(gen.hash64("http://a.com/search?q=furi&page=2&session=1"));
+    keys.insert(gen.hash64("http://b.com/search?session=2&page=2&q=furi"));
+    CHECK(keys.size() == 1);
+}
@@ -4,6 +4,8 @@
 #include <doctest/doctest.h>
 #include <furi/furi.hpp>
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using namespace furi;
@@ -65,6 +67,26 @@ TEST_CASE("string view")
     std_sv_test(abc);
 }
 
+TEST_CASE("case-insensitive")
+{
+    CHECK(iequals("Example.COM", "example.com"));
+    CHECK(!iequals("example.com", "example.co"));
+    CHECK(iequals({}, ""));
+    CHECK(icmp("HTTP", "https") < 0);
+    CHECK(icmp("b", "A") > 0);
+
+    std::unordered_map<std::string, int, sv_ihash, sv_iequal> schemes = {{"http", 80}, {"https", 443}};
+    CHECK(schemes.count("HTTPS") == 1);
+    CHECK(schemes.find(std::string("Http"))->second == 80);
+    CHECK(sv_ihash{}("WS") == sv_ihash{}("ws"));
+
+    std::unordered_set<opt_string_view> views = {"a", "b"};
+    CHECK(views.count("a") == 1);
+    CHECK(views.count(std::string("c")) == 0);
+    CHECK(std::hash<opt_string_view>{}("abc") == std::hash<std::string_view>{}("abc"));
+    CHECK(sv_hash{}("abc") == std::hash<std::string>{}("abc"));
+}
+
 TEST_CASE("uri_split")
 {
     std::string_view uri = "http://x.com:43/abc?xyz#top";
@@ -93,6 +115,96 @@ TEST_CASE("uri_split")
     CHECK(s.req_path.empty());
 }
 
+TEST_CASE("uri_split masked")
+{
+    std::string_view uri = "http://x.com:43/abc?xyz#top";
+    auto s = uri_split::from_uri<capi::FURI_URI_PATH | capi::FURI_URI_FRAGMENT>(uri);
+    CHECK_FALSE(s.scheme);
+    CHECK_FALSE(s.authority);
+    CHECK(s.path == "/abc");
+    CHECK_FALSE(s.query);
+    CHECK(s.fragment == "top");
+    CHECK_FALSE(s.req_path);
+
+    CHECK(uri_split::from_uri<capi::FURI_URI_AUTHORITY>(uri).authority == "x.com:43");
+    CHECK(uri_split::from_uri<capi::FURI_URI_REQ_PATH>("a-b://asdf").req_path == "/");
+
+    constexpr auto cs = uri_split::from_uri<capi::FURI_URI_QUERY>("http://x.com:43/abc?xyz#top");
+    static_assert(cs.query == "xyz");
+    static_assert(!cs.path);
+}
+
+TEST_CASE("uri_split_columns")
+{
+    std::vector<opt_string_view> uris = {"http://x.com:43/abc?xyz#top", "a-b://asdf", "x/y?q"};
+    auto cols = uri_split_columns::from_uris(uris);
+    CHECK(cols.size() == 3);
+    for (size_t i = 0; i < uris.size(); ++i)
+    {
+        auto e = uri_split::from_uri(uris[i]);
+        auto s = cols.at(i, uris[i]);
+        CHECK(s.scheme.data() == e.scheme.data());
+        CHECK(s.scheme == e.scheme);
+        CHECK(s.authority == e.authority);
+        CHECK(s.path.data() == e.path.data());
+        CHECK(s.path == e.path);
+        CHECK(s.query == e.query);
+        CHECK(s.fragment == e.fragment);
+        CHECK(s.req_path == e.req_path);
+    }
+
+    auto q = uri_split_columns::from_uris(uris, capi::FURI_URI_QUERY);
+    CHECK(q.query.enabled());
+    CHECK_FALSE(q.path.enabled());
+    CHECK(q.query.get(0, uris[0]) == "xyz");
+    CHECK_FALSE(q.query.get(1, uris[1]));
+    CHECK(q.query.get(2, uris[2]) == "q");
+    CHECK_FALSE(q.at(0, uris[0]).path);
+    CHECK_FALSE(q.path.get(0, uris[0])); // not requested
+    CHECK_FALSE(q.fragment.get(2, uris[2]));
+}
+
+TEST_CASE("uri_split_compact")
+{
+    std::string_view uri = "http://x.com:43/abc?xyz#top";
+    auto c = uri_split_compact::from_uri(uri);
+    auto base = uri.data();
+    CHECK(c.scheme(base) == "http");
+    CHECK(c.authority(base) == "x.com:43");
+    CHECK(c.path(base) == "/abc");
+    CHECK(c.query(base) == "xyz");
+    CHECK(c.fragment(base) == "top");
+    CHECK(c.req_path(base) == "/abc?xyz#top");
+
+    auto s = c.to_split(base);
+    CHECK(s.path.data() == uri.data() + 15);
+
+    std::string copy(uri);
+    CHECK(c.query(copy.data()) == "xyz"); // offsets are valid for copies
+
+    const char* ao = "a-b://asdf";
+    auto c2 = uri_split_compact::from_split(uri_split::from_uri(ao), ao);
+    CHECK(c2.authority(ao) == "asdf");
+    CHECK_FALSE(c2.path(ao));
+    CHECK(c2.req_path(ao) == "/");
+}
+
+TEST_CASE("uri_stream")
+{
+    std::string_view uri = "https://x.com/a/b?q=1#f";
+    uri_stream st;
+    st.feed(uri.substr(0, 10));
+    CHECK(st.complete() == capi::FURI_URI_SCHEME);
+    CHECK(st.current().scheme(uri.data()) == "https");
+    st.feed(uri.substr(10, 8));
+    st.feed(uri.substr(18));
+    auto c = st.finish();
+    CHECK(c.path(uri.data()) == "/a/b");
+    CHECK(c.query(uri.data()) == "q=1");
+    CHECK(c.fragment(uri.data()) == "f");
+    CHECK(c.req_path(uri.data()) == "/a/b?q=1#f");
+}
+
 TEST_CASE("authority_split")
 {
     auto authority = "alice:pass@foo.com:44";
@@ -124,6 +236,26 @@ TEST_CASE("userinfo_split")
     CHECK_FALSE(userinfo_split::get_password_from_userinfo("user"));
 }
 
+TEST_CASE("uri_decomposition")
+{
+    auto d = uri_decomposition::from_uri("https://user:pw@[::1]:8080/a/b?c#d");
+    CHECK(d.uri.scheme == "https");
+    CHECK(d.uri.authority == "user:pw@[::1]:8080");
+    CHECK(d.authority.userinfo == "user:pw");
+    CHECK(d.userinfo.username == "user");
+    CHECK(d.userinfo.password == "pw");
+    CHECK(d.authority.host == "[::1]");
+    CHECK(d.authority.port == "8080");
+    CHECK(d.uri.path == "/a/b");
+    CHECK(d.uri.query == "c");
+    CHECK(d.uri.fragment == "d");
+
+    d = uri_decomposition::from_uri("/x");
+    CHECK_FALSE(d.uri.authority);
+    CHECK_FALSE(d.authority.host);
+    CHECK_FALSE(d.userinfo.username);
+}
+
 TEST_CASE("path_view/iter")
 {
     std::vector<std::string_view> vec = {"foo", "bar", "baz", ""};
@@ -138,6 +270,25 @@ TEST_CASE("path_view/iter")
     CHECK(vec == check);
 }
 
+TEST_CASE("host_labels_view/iter")
+{
+    std::vector<std::string_view> vec = {"com", "example", "www"};
+
+    host_labels_view hv = "www.example.com.";
+    std::vector<std::string_view> check;
+    for (auto e : hv)
+    {
+        check.push_back(e);
+    }
+
+    CHECK(vec == check);
+
+    constexpr host_labels_view chv = "a.b";
+    static_assert(*chv.begin() == "b");
+    CHECK(host_labels_view("").begin() == host_labels_view("").end());
+    CHECK(host_labels_view(".").begin() == host_labels_view(".").end());
+}
+
 TEST_CASE("query_view/iter")
 {
     std::vector<query_item> vec = {{"xy", "23"}, {"f", {}}, {"q", "z"}};
@@ -151,3 +302,269 @@ TEST_CASE("query_view/iter")
 
     CHECK(vec == check);
 }
+
+// compile-time checks of the native implementations
+constexpr auto ct_split = uri_split::from_uri("http://x.com:43/abc?xyz#top");
+static_assert(ct_split.scheme == "http");
+static_assert(ct_split.authority == "x.com:43");
+static_assert(ct_split.path == "/abc");
+static_assert(ct_split.query == "xyz");
+static_assert(ct_split.fragment == "top");
+static_assert(ct_split.req_path == "/abc?xyz#top");
+static_assert(uri_split::from_uri("a-b://asdf").req_path == "/");
+static_assert(!uri_split::from_uri("a-b://asdf").path);
+static_assert(authority_split::from_authority("[::1]:80").host == "[::1]");
+static_assert(!authority_split::from_authority("[::1]x").host);
+static_assert(userinfo_split::from_userinfo("u:p:q").password == "p:q");
+static_assert(is_valid_uri("https://user@example.com:443/a/b?c=d#e"));
+static_assert(validate_uri("http://x:8o/").offset == 10);
+
+constexpr size_t ct_count_segments(path_view pv)
+{
+    size_t n = 0;
+    for (auto seg : pv) n += !seg.empty();
+    return n;
+}
+static_assert(ct_count_segments("/a/b//c/") == 3);
+
+constexpr opt_string_view ct_query_value(query_view qv, std::string_view key)
+{
+    for (auto [k, v] : qv)
+    {
+        if (k == key) return v;
+    }
+    return {};
+}
+static_assert(ct_query_value("a=1&b=2=3&c", "b=2") == "3"); // the key ends at the last '='
+static_assert(!ct_query_value("a=1&b=2&c", "c"));
+
+void check_same(const uri_split& a, const uri_split& b)
+{
+    CHECK(a.scheme.data() == b.scheme.data());
+    CHECK(a.scheme.size() == b.scheme.size());
+    CHECK(a.authority.data() == b.authority.data());
+    CHECK(a.authority.size() == b.authority.size());
+    CHECK(a.path.data() == b.path.data());
+    CHECK(a.path.size() == b.path.size());
+    CHECK(a.query.data() == b.query.data());
+    CHECK(a.query.size() == b.query.size());
+    CHECK(a.fragment.data() == b.fragment.data());
+    CHECK(a.fragment.size() == b.fragment.size());
+    CHECK(a.req_path == b.req_path);
+    CHECK(a.req_path.null() == b.req_path.null());
+}
+
+TEST_CASE("native implementation")
+{
+    const char* uris[] = {
+        "", "/", "x", "a:", "a:b", "a://", "a://b", "a://b/", "a:/b", "//a/b", "a?b", "a?b/c?d", "a#b?c", "?#",
+        "http://x.com:43/abc?xyz#top", "https://u:p@[::1]:8080/a/b?c#d", "h://[::1", "h://[::1]x/", "h://a@b@c:d:e/",
+        "mailto:a@b.c", "/a/b?c=d&e#f#g", "x:y:z/w",
+    };
+    for (auto u : uris)
+    {
+        INFO(u);
+        auto d = uri_decomposition::from_uri(u);
+        auto n = uri_decomposition::from_uri_native(u);
+        check_same(d.uri, n.uri);
+        CHECK(d.authority.userinfo.data() == n.authority.userinfo.data());
+        CHECK(d.authority.host == n.authority.host);
+        CHECK(d.authority.host.null() == n.authority.host.null());
+        CHECK(d.authority.port == n.authority.port);
+        CHECK(d.authority.port.null() == n.authority.port.null());
+        CHECK(d.userinfo.username == n.userinfo.username);
+        CHECK(d.userinfo.password.data() == n.userinfo.password.data());
+        check_same(uri_split::from_uri(u), uri_split::from_uri_native(u));
+
+        auto v = validate_uri(u);
+        auto nv = impl::validate_split(n.uri, n.authority, u);
+        CHECK(v.component == nv.component);
+        CHECK(v.offset == nv.offset);
+
+        std::vector<std::string_view> segs, c_segs;
+        for (auto seg : path_view(n.uri.path)) segs.push_back(seg);
+        if (!n.uri.path.empty())
+        {
+            auto path = n.uri.path.c_sv();
+            for (auto pi = capi::furi_make_path_iter_begin(path); !capi::furi_path_iter_is_done(pi); capi::furi_path_iter_next(&pi))
+            {
+                c_segs.push_back(opt_string_view(capi::furi_path_iter_get_value(pi)));
+            }
+            CHECK(segs == c_segs);
+        }
+
+        std::vector<query_item> items, c_items;
+        for (auto item : query_view(n.uri.query)) items.push_back(item);
+        auto query = n.uri.query.c_sv();
+        for (auto qi = capi::furi_make_query_iter_begin(query); !capi::furi_query_iter_is_done(qi); capi::furi_query_iter_next(&qi))
+        {
+            auto kv = capi::furi_query_iter_get_value(qi);
+            c_items.push_back({opt_string_view(kv.key), opt_string_view(kv.value)});
+        }
+        CHECK(items == c_items);
+    }
+}
+
+TEST_CASE("uri literals")
+{
+    using namespace furi::literals;
+    constexpr auto u = "https://user@example.com:8080/a/b?c=d#e"_uri;
+    static_assert(u.str.size() == 39);
+    static_assert(u.parts.uri.path == "/a/b");
+    static_assert(u.parts.authority.port == "8080");
+    static_assert(u.parts.userinfo.username == "user");
+    CHECK(u.parts.uri.query.data() == u.str.data() + 34);
+
+    // doesn't compile:
+    // constexpr auto bad = "https://exa mple.com/"_uri;
+    CHECK_THROWS_AS("https://exa mple.com/"_uri, std::invalid_argument);
+}
+
+TEST_CASE("pct_decode")
+{
+    char buf[32];
+    opt_string_view plain = "abc";
+    CHECK_FALSE(needs_pct_decoding(plain));
+    CHECK(pct_decode(plain, buf).data() == plain.data());
+
+    auto d = pct_decode("a%20b+c", buf, true);
+    CHECK(d == "a b c");
+    CHECK(d.data() == buf);
+
+    CHECK(pct_decode_to_string("x%2Fy") == "x/y");
+    CHECK(pct_decode_to_string("") == "");
+}
+
+TEST_CASE("validate_uri")
+{
+    CHECK(furi::is_valid_uri("https://user@example.com:443/a/b?c=d#e"));
+    CHECK(furi::is_valid_uri(""));
+    CHECK_FALSE(furi::is_valid_uri("https://example.com/a b"));
+
+    auto v = furi::validate_uri("http://x:8o/");
+    CHECK(v);
+    CHECK(v.component == furi::capi::FURI_URI_PORT);
+    CHECK(v.offset == 10);
+
+    furi::uri_violation sv;
+    auto split = furi::split_uri_strict("http://ex.com/p?q=<1>", sv);
+    CHECK(split.authority == "ex.com");
+    CHECK(split.query == "q=<1>");
+    CHECK(sv.component == furi::capi::FURI_URI_QUERY);
+    CHECK(sv.offset == 18);
+
+    split = furi::split_uri_strict("http://ex.com/p?q=1", sv);
+    CHECK_FALSE(sv);
+    CHECK(split.path == "/p");
+}
+
+TEST_CASE("scheme")
+{
+    static_assert(classify_scheme("HTTPS") == capi::FURI_SCHEME_HTTPS);
+    static_assert(classify_scheme("foo") == capi::FURI_SCHEME_OTHER);
+    static_assert(classify_scheme({}) == capi::FURI_SCHEME_NONE);
+    static_assert(default_port(classify_scheme("ws")) == 80);
+    static_assert(scheme_name(capi::FURI_SCHEME_MAILTO) == "mailto");
+
+    auto s = uri_split::from_uri("Ftp://example.com/file");
+    CHECK(classify_scheme(s.scheme) == capi::FURI_SCHEME_FTP);
+    CHECK(classify_scheme(s.scheme) == capi::furi_classify_scheme(s.scheme.c_sv()));
+    CHECK(default_port(classify_scheme(s.scheme)) == 21);
+    CHECK(default_port(classify_scheme("gopher")) == 70);
+    CHECK(default_port(classify_scheme("file")) == 0);
+}
+
+TEST_CASE("host and port")
+{
+    auto as = furi::authority_split::from_authority("[2001:db8::7]:443");
+    auto ha = furi::host_address::from_host(as.host);
+    CHECK(ha.kind == furi::capi::FURI_HOST_IPV6);
+    CHECK(ha.ipv6[0] == 0x20);
+    CHECK(ha.ipv6[3] == 0xb8);
+    CHECK(ha.ipv6[15] == 7);
+    CHECK(furi::parse_port(as.port) == 443);
+
+    ha = furi::host_address::from_host("172.16.0.3");
+    CHECK(ha);
+    CHECK(ha.kind == furi::capi::FURI_HOST_IPV4);
+    CHECK(ha.ipv4 == 0xAC100003);
+
+    CHECK_FALSE(furi::host_address::from_host("[x]"));
+
+    CHECK(furi::parse_ipv4("8.8.4.4") == 0x08080404u);
+    CHECK_FALSE(furi::parse_ipv4("8.8.4"));
+    CHECK(furi::parse_ipv6("::2")->at(15) == 2);
+    CHECK_FALSE(furi::parse_ipv6("::2::"));
+    CHECK_FALSE(furi::parse_port("70000"));
+    CHECK_FALSE(furi::parse_port(as.host));
+}
+
+TEST_CASE("query_index")
+{
+    furi::query_index idx("a=1&b=2&a=3&c&d=");
+    CHECK(idx.size() == 5);
+    CHECK_FALSE(idx.empty());
+
+    std::vector<std::string> keys;
+    for (auto [k, v] : idx) keys.emplace_back(k);
+    CHECK(keys == std::vector<std::string>{"a", "b", "a", "c", "d"});
+
+    auto f = idx.find("b");
+    REQUIRE(f != idx.end());
+    CHECK((*f).second == "2");
+    CHECK(idx.find("x") == idx.end());
+
+    std::vector<std::string> values;
+    for (auto [k, v] : idx.find_all("a")) values.emplace_back(v);
+    CHECK(values == std::vector<std::string>{"1", "3"});
+    CHECK(idx.find_all("x").empty());
+
+    CHECK(idx.count("a") == 2);
+    CHECK(idx.count("c") == 1);
+    CHECK(idx.count("x") == 0);
+    CHECK(idx.contains("c"));
+    CHECK_FALSE(idx.contains("e"));
+    CHECK(idx.value("b") == "2");
+    CHECK_FALSE(idx.value("c")); // no value
+    CHECK(idx.value("d"));
+    CHECK(idx.value("d").empty());
+    CHECK_FALSE(idx.value("x"));
+
+    // more items than the inline storage
+    std::string big;
+    for (int i = 0; i < 100; ++i) big += "&k" + std::to_string(i) + "=" + std::to_string(i);
+    furi::query_index bi(std::string_view(big).substr(1));
+    CHECK(bi.size() == 100);
+    CHECK(bi.value("k0") == "0");
+    CHECK(bi.value("k99") == "99");
+    CHECK(bi.count("k50") == 1);
+
+    furi::query_index empty("");
+    CHECK(empty.empty());
+    CHECK(empty.begin() == empty.end());
+}
+
+TEST_CASE("query_keys")
+{
+    static constexpr furi::query_keys keys("utm_source", "utm_medium", "id", "page");
+    static_assert(keys.size() == 4);
+
+    auto r = keys.extract("utm_medium=email&x=1&id=7&utm_source=news&id=8");
+    CHECK(r[0].second == "news");
+    CHECK(r[1].second == "email");
+    CHECK(r[2].second == "7");
+    CHECK_FALSE(r[3].first);
+    CHECK_FALSE(r[3].second);
+
+    std::string key = "q";
+    furi::query_keys<1> runtime(key);
+    CHECK(runtime.extract("a=1&q=2")[0].second == "2");
+    CHECK_FALSE(runtime.extract("")[0].first);
+
+    // the keys are views, so temporary strings would dangle
+    static_assert(std::is_constructible_v<furi::query_keys<1>, std::string&>);
+    static_assert(std::is_constructible_v<furi::query_keys<1>, std::string_view>);
+    static_assert(std::is_constructible_v<furi::query_keys<2>, const char*, opt_string_view>);
+    static_assert(!std::is_constructible_v<furi::query_keys<1>, std::string>);
+    static_assert(!std::is_constructible_v<furi::query_keys<2>, const char*, std::string&&>);
+}
@@ -0,0 +1,125 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/http.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+
+furi_http_request_line parse(const char* str)
+{
+    return furi_parse_http_request_line(furi_make_sv_from_string(str));
+}
+
+void method(void)
+{
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_GET, furi_http_method_from_sv(furi_make_sv_from_string("GET")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_HEAD, furi_http_method_from_sv(furi_make_sv_from_string("HEAD")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_POST, furi_http_method_from_sv(furi_make_sv_from_string("POST")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_PUT, furi_http_method_from_sv(furi_make_sv_from_string("PUT")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_DELETE, furi_http_method_from_sv(furi_make_sv_from_string("DELETE")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_CONNECT, furi_http_method_from_sv(furi_make_sv_from_string("CONNECT")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_OPTIONS, furi_http_method_from_sv(furi_make_sv_from_string("OPTIONS")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TRACE, furi_http_method_from_sv(furi_make_sv_from_string("TRACE")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_PATCH, furi_http_method_from_sv(furi_make_sv_from_string("PATCH")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_OTHER, furi_http_method_from_sv(furi_make_sv_from_string("get")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_OTHER, furi_http_method_from_sv(furi_make_sv_from_string("PROPFIND")));
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_OTHER, furi_http_method_from_sv(furi_make_sv_from_string("")));
+}
+
+void origin_form(void)
+{
+    furi_http_request_line rl = parse("GET /over/there?name=ferret#x HTTP/1.1\r\n");
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_ORIGIN, rl.target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_GET, rl.method_id);
+    TEST_ASSERT_EXPECT_SV("GET", rl.method);
+    TEST_ASSERT_EXPECT_SV("/over/there?name=ferret#x", rl.target);
+    TEST_ASSERT_EXPECT_SV("HTTP/1.1", rl.version);
+    TEST_ASSERT_EQUAL_INT(1, rl.version_major);
+    TEST_ASSERT_EQUAL_INT(1, rl.version_minor);
+    TEST_ASSERT_NULL(rl.split.scheme.begin);
+    TEST_ASSERT_NULL(rl.split.authority.begin);
+    TEST_ASSERT_EXPECT_SV("/over/there", rl.split.path);
+    TEST_ASSERT_EXPECT_SV("name=ferret", rl.split.query);
+    TEST_ASSERT_EXPECT_SV("x", rl.split.fragment);
+    TEST_ASSERT_EXPECT_SV("/over/there?name=ferret#x", rl.split.req_path);
+
+    // fast path is the same as the generic split
+    const char* targets[] = {"/", "/a:b/c", "/x?y", "/x#y?z", "/?#", "/a?b#c"};
+    for (size_t i = 0; i < sizeof(targets) / sizeof(const char*); ++i)
+    {
+        furi_sv t = furi_make_sv_from_string(targets[i]);
+        furi_uri_split a = furi_split_uri(t);
+        furi_uri_split b = furi_split_origin_form(t);
+        TEST_ASSERT(memcmp(&a, &b, sizeof(a)) == 0);
+    }
+
+    rl = parse("POST /submit HTTP/1.0");
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_ORIGIN, rl.target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_POST, rl.method_id);
+    TEST_ASSERT_EQUAL_INT(0, rl.version_minor);
+    TEST_ASSERT_NULL(rl.split.query.begin);
+}
+
+void other_forms(void)
+{
+    furi_http_request_line rl = parse("GET http://www.example.org:8080/pub/WWW/TheProject.html HTTP/1.1\n");
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_ABSOLUTE, rl.target_form);
+    TEST_ASSERT_EXPECT_SV("http", rl.split.scheme);
+    TEST_ASSERT_EXPECT_SV("www.example.org:8080", rl.split.authority);
+    TEST_ASSERT_EXPECT_SV("/pub/WWW/TheProject.html", rl.split.path);
+
+    rl = parse("CONNECT www.example.com:80 HTTP/1.1");
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_AUTHORITY, rl.target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_CONNECT, rl.method_id);
+    TEST_ASSERT_EXPECT_SV("www.example.com:80", rl.split.authority);
+    TEST_ASSERT_NULL(rl.split.scheme.begin);
+    TEST_ASSERT_NULL(rl.split.path.begin);
+    TEST_ASSERT_NULL(rl.split.req_path.begin);
+
+    rl = parse("OPTIONS * HTTP/1.1");
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_ASTERISK, rl.target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_OPTIONS, rl.method_id);
+    TEST_ASSERT_EXPECT_SV("*", rl.target);
+
+    rl = parse("PROPFIND /x HTTP/1.1");
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_ORIGIN, rl.target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_OTHER, rl.method_id);
+    TEST_ASSERT_EXPECT_SV("PROPFIND", rl.method);
+
+    rl = parse("M-SEARCH* /x HTTP/1.1"); // tchars
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_ORIGIN, rl.target_form);
+    TEST_ASSERT_EXPECT_SV("M-SEARCH*", rl.method);
+}
+
+void invalid(void)
+{
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET /").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET  HTTP/1.1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse(" / HTTP/1.1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET / HTTP/1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET / HTTX/1.1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET /a b HTTP/1.1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET relative/path HTTP/1.1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("G(T /x HTTP/1.1").target_form); // not a token
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GE\x80 /x HTTP/1.1").target_form);
+    TEST_ASSERT_EQUAL_INT(FURI_HTTP_TARGET_INVALID, parse("GET * HTTP/1.1").target_form); // asterisk is only for OPTIONS
+    TEST_ASSERT_NULL(parse("GET / HTTP/x.1").method.begin);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(method);
+    RUN_TEST(origin_form);
+    RUN_TEST(other_forms);
+    RUN_TEST(invalid);
+    return UNITY_END();
+}
@@ -0,0 +1,24 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/http.hpp>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-http");
+
+TEST_CASE("http_request_line")
+{
+    auto rl = http_request_line::from_line("GET /a/b?c=d HTTP/1.1\r\n");
+    CHECK(!!rl);
+    CHECK(rl.method_id == capi::FURI_HTTP_GET);
+    CHECK(rl.method == "GET");
+    CHECK(rl.target_form == capi::FURI_HTTP_TARGET_ORIGIN);
+    CHECK(rl.split.path == "/a/b");
+    CHECK(rl.split.query == "c=d");
+    CHECK_FALSE(rl.split.scheme);
+    CHECK(rl.version == "HTTP/1.1");
+
+    CHECK_FALSE(http_request_line::from_line("nope"));
+}
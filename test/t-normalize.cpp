@@ -0,0 +1,26 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/normalize.hpp>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-normalize");
+
+TEST_CASE("normalize_uri")
+{
+    CHECK(normalize_uri("HTTP://Example.com:80/a/../b") == "http://example.com/b");
+
+    std::string out = "key: ";
+    out.reserve(100);
+    auto data = out.data();
+    auto s = normalize_uri("https://X.org:443/?q=%7e", out);
+    CHECK(out == "key: https://x.org/?q=~");
+    CHECK(out.data() == data); // no reallocation
+    CHECK(s.scheme == "https");
+    CHECK(s.authority == "x.org");
+    CHECK(s.path == "/");
+    CHECK(s.query == "q=~");
+    CHECK(s.query.data() == out.data() + out.size() - 3);
+}
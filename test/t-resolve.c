@@ -0,0 +1,158 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/resolve.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+
+void test_split_reference(const char* str,
+    const char* scheme,
+    const char* authority,
+    const char* path,
+    const char* query,
+    const char* fragment)
+{
+    furi_uri_split s = furi_split_reference(furi_make_sv_from_string(str));
+    TEST_ASSERT_EXPECT_SV(scheme, s.scheme);
+    TEST_ASSERT(!scheme == !s.scheme.begin);
+    TEST_ASSERT_EXPECT_SV(authority, s.authority);
+    TEST_ASSERT(!authority == !s.authority.begin);
+    TEST_ASSERT_EXPECT_SV(path, s.path);
+    TEST_ASSERT_NOT_NULL(s.path.begin);
+    TEST_ASSERT_EXPECT_SV(query, s.query);
+    TEST_ASSERT(!query == !s.query.begin);
+    TEST_ASSERT_EXPECT_SV(fragment, s.fragment);
+    TEST_ASSERT(!fragment == !s.fragment.begin);
+}
+
+void split_reference(void)
+{
+    test_split_reference("", NULL, NULL, "", NULL, NULL);
+    test_split_reference("g", NULL, NULL, "g", NULL, NULL);
+    test_split_reference("g?y", NULL, NULL, "g", "y", NULL);
+    test_split_reference("?y", NULL, NULL, "", "y", NULL);
+    test_split_reference("#s", NULL, NULL, "", NULL, "s");
+    test_split_reference("g?y#s", NULL, NULL, "g", "y", "s");
+    test_split_reference("//g", NULL, "g", "", NULL, NULL);
+    test_split_reference("//g?x", NULL, "g", "", "x", NULL);
+    test_split_reference("./g:h", NULL, NULL, "./g:h", NULL, NULL);
+    test_split_reference("g:h", "g", NULL, "h", NULL, NULL);
+    test_split_reference("http://a/b/c/d;p?q", "http", "a", "/b/c/d;p", "q", NULL);
+    test_split_reference("a?b:c", NULL, NULL, "a", "b:c", NULL);
+}
+
+void test_resolve(const char* base, const char* ref, const char* expected)
+{
+    char buf[128];
+    furi_uri_split bs = furi_split_reference(furi_make_sv_from_string(base));
+    furi_uri_split rs = furi_split_reference(furi_make_sv_from_string(ref));
+    TEST_ASSERT(furi_resolve_max_length(&bs, &rs) <= sizeof(buf));
+    furi_uri_split s = furi_resolve_reference(&bs, &rs, buf);
+    furi_sv r = furi_make_sv(buf, s.req_path.end);
+    TEST_ASSERT_EXPECT_SV(expected, r);
+    TEST_ASSERT(furi_sv_length(r) <= furi_resolve_max_length(&bs, &rs));
+
+    furi_uri_split e = furi_split_reference(r);
+    TEST_ASSERT_EQUAL_PTR(e.scheme.end, s.scheme.end);
+    TEST_ASSERT_EQUAL_PTR(e.authority.begin, s.authority.begin);
+    TEST_ASSERT_EQUAL_PTR(e.path.begin, s.path.begin);
+    TEST_ASSERT_EQUAL_PTR(e.path.end, s.path.end);
+    TEST_ASSERT_EQUAL_PTR(e.query.begin, s.query.begin);
+    TEST_ASSERT_EQUAL_PTR(e.fragment.begin, s.fragment.begin);
+}
+
+void resolve(void)
+{
+    // RFC 3986 5.4
+    const char* base = "http://a/b/c/d;p?q";
+
+    // normal
+    test_resolve(base, "g:h", "g:h");
+    test_resolve(base, "g", "http://a/b/c/g");
+    test_resolve(base, "./g", "http://a/b/c/g");
+    test_resolve(base, "g/", "http://a/b/c/g/");
+    test_resolve(base, "/g", "http://a/g");
+    test_resolve(base, "//g", "http://g");
+    test_resolve(base, "?y", "http://a/b/c/d;p?y");
+    test_resolve(base, "g?y", "http://a/b/c/g?y");
+    test_resolve(base, "#s", "http://a/b/c/d;p?q#s");
+    test_resolve(base, "g#s", "http://a/b/c/g#s");
+    test_resolve(base, "g?y#s", "http://a/b/c/g?y#s");
+    test_resolve(base, ";x", "http://a/b/c/;x");
+    test_resolve(base, "g;x", "http://a/b/c/g;x");
+    test_resolve(base, "g;x?y#s", "http://a/b/c/g;x?y#s");
+    test_resolve(base, "", "http://a/b/c/d;p?q");
+    test_resolve(base, ".", "http://a/b/c/");
+    test_resolve(base, "./", "http://a/b/c/");
+    test_resolve(base, "..", "http://a/b/");
+    test_resolve(base, "../", "http://a/b/");
+    test_resolve(base, "../g", "http://a/b/g");
+    test_resolve(base, "../..", "http://a/");
+    test_resolve(base, "../../", "http://a/");
+    test_resolve(base, "../../g", "http://a/g");
+
+    // abnormal
+    test_resolve(base, "../../../g", "http://a/g");
+    test_resolve(base, "../../../../g", "http://a/g");
+    test_resolve(base, "/./g", "http://a/g");
+    test_resolve(base, "/../g", "http://a/g");
+    test_resolve(base, "g.", "http://a/b/c/g.");
+    test_resolve(base, ".g", "http://a/b/c/.g");
+    test_resolve(base, "g..", "http://a/b/c/g..");
+    test_resolve(base, "..g", "http://a/b/c/..g");
+    test_resolve(base, "./../g", "http://a/b/g");
+    test_resolve(base, "./g/.", "http://a/b/c/g/");
+    test_resolve(base, "g/./h", "http://a/b/c/g/h");
+    test_resolve(base, "g/../h", "http://a/b/c/h");
+    test_resolve(base, "g;x=1/./y", "http://a/b/c/g;x=1/y");
+    test_resolve(base, "g;x=1/../y", "http://a/b/c/y");
+    test_resolve(base, "g?y/./x", "http://a/b/c/g?y/./x");
+    test_resolve(base, "g?y/../x", "http://a/b/c/g?y/../x");
+    test_resolve(base, "g#s/./x", "http://a/b/c/g#s/./x");
+    test_resolve(base, "g#s/../x", "http://a/b/c/g#s/../x");
+    test_resolve(base, "http:g", "http:g");
+
+    // base with no path
+    test_resolve("http://a", "g", "http://a/g");
+    test_resolve("http://a", "?x", "http://a?x");
+}
+
+void resolve_batch(void)
+{
+    const char* base = "http://a/b/c/d;p?q";
+    furi_uri_split bs = furi_split_uri(furi_make_sv_from_string(base));
+
+    furi_sv refs[] = {
+        furi_make_sv_from_string("g"),
+        furi_make_sv_from_string("../x?y"),
+        furi_make_sv_from_string("#f"),
+    };
+    furi_uri_split results[3];
+    char buf[128];
+
+    size_t n = furi_resolve_batch(&bs, refs, 3, buf, sizeof(buf), results);
+    TEST_ASSERT_EQUAL_size_t(3, n);
+    TEST_ASSERT_EXPECT_SV("http://a/b/c/g", furi_make_sv(buf, results[0].req_path.end));
+    TEST_ASSERT_EXPECT_SV("http://a/b/x?y", furi_make_sv(results[0].req_path.end, results[1].req_path.end));
+    TEST_ASSERT_EXPECT_SV("/b/c/d;p?q#f", results[2].req_path);
+    TEST_ASSERT_EXPECT_SV("y", results[1].query);
+
+    // not enough room
+    n = furi_resolve_batch(&bs, refs, 3, buf, 30, results);
+    TEST_ASSERT_EQUAL_size_t(1, n);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(split_reference);
+    RUN_TEST(resolve);
+    RUN_TEST(resolve_batch);
+    return UNITY_END();
+}
@@ -0,0 +1,28 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/resolve.hpp>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-resolve");
+
+TEST_CASE("uri_resolver")
+{
+    auto s = split_reference("g?y#s");
+    CHECK(s.path == "g");
+    CHECK(s.query == "y");
+    CHECK(s.fragment == "s");
+
+    uri_resolver r("http://a/b/c/d;p?q");
+    CHECK(r.resolve("../g") == "http://a/b/g");
+    CHECK(r.resolve("//x/y") == "http://x/y");
+
+    std::string out;
+    auto rs = r.resolve("g?y", out);
+    CHECK(out == "http://a/b/c/g?y");
+    CHECK(rs.path == "/b/c/g");
+    CHECK(rs.path.data() == out.data() + 8);
+    CHECK(rs.query == "y");
+}
@@ -0,0 +1,164 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/router.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+
+static furi_router_node nodes[128];
+
+static furi_router_add_result add(furi_router* r, const char* pattern, int route)
+{
+    return furi_router_add(r, furi_make_sv_from_string(pattern), route);
+}
+
+static furi_router_match match(const furi_router* r, const char* path)
+{
+    return furi_router_match_path(r, furi_make_sv_from_string(path));
+}
+
+void static_routes(void)
+{
+    furi_router r = furi_make_router(nodes, 128);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users/list", 0));
+    TEST_ASSERT_EQUAL(2, r.size); // a single node for both segments
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users/new", 1));
+    TEST_ASSERT_EQUAL(4, r.size); // split at "users"
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users", 2));
+    TEST_ASSERT_EQUAL(4, r.size);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/user", 3));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/", 4));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "", 5));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users/", 6));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_DUPLICATE, add(&r, "/users/new", 7));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_DUPLICATE, add(&r, "users/new", 7));
+
+    TEST_ASSERT_EQUAL(0, match(&r, "/users/list").route);
+    TEST_ASSERT_EQUAL(0, match(&r, "users/list").route);
+    TEST_ASSERT_EQUAL(1, match(&r, "/users/new").route);
+    TEST_ASSERT_EQUAL(2, match(&r, "/users").route);
+    TEST_ASSERT_EQUAL(3, match(&r, "/user").route);
+    TEST_ASSERT_EQUAL(4, match(&r, "/").route);
+    TEST_ASSERT_EQUAL(5, match(&r, "").route);
+    TEST_ASSERT_EQUAL(6, match(&r, "/users/").route);
+    TEST_ASSERT_EQUAL(-1, match(&r, "/users/lis").route);
+    TEST_ASSERT_EQUAL(-1, match(&r, "/users/listx").route);
+    TEST_ASSERT_EQUAL(-1, match(&r, "/users/list/").route);
+    TEST_ASSERT_EQUAL(-1, match(&r, "/use").route);
+    TEST_ASSERT_EQUAL(-1, match(&r, "//").route);
+    TEST_ASSERT_EQUAL(0, match(&r, "/users/list").num_captures);
+}
+
+void captures(void)
+{
+    furi_router r = furi_make_router(nodes, 128);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users/:id", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users/:id/posts/:post", 1));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/users/me", 2));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/files/*path", 3));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_DUPLICATE, add(&r, "/users/:name", 4));
+
+    furi_router_match m = match(&r, "/users/42");
+    TEST_ASSERT_EQUAL(0, m.route);
+    TEST_ASSERT_EQUAL(1, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("42", m.captures[0]);
+
+    m = match(&r, "/users/me");
+    TEST_ASSERT_EQUAL(2, m.route);
+    TEST_ASSERT_EQUAL(0, m.num_captures);
+
+    m = match(&r, "/users/me/posts/x");
+    TEST_ASSERT_EQUAL(1, m.route);
+    TEST_ASSERT_EQUAL(2, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("me", m.captures[0]);
+    TEST_ASSERT_EXPECT_SV("x", m.captures[1]);
+
+    m = match(&r, "/users/");
+    TEST_ASSERT_EQUAL(-1, m.route); // params don't capture empty segments
+    TEST_ASSERT_EQUAL(0, m.num_captures);
+    TEST_ASSERT_EQUAL(-1, match(&r, "/users/42/posts").route);
+    TEST_ASSERT_EQUAL(-1, match(&r, "/users/42/posts/").route);
+
+    m = match(&r, "/files/a/b.txt");
+    TEST_ASSERT_EQUAL(3, m.route);
+    TEST_ASSERT_EQUAL(1, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("a/b.txt", m.captures[0]);
+
+    m = match(&r, "/files/");
+    TEST_ASSERT_EQUAL(3, m.route);
+    TEST_ASSERT_EXPECT_SV("", m.captures[0]);
+
+    TEST_ASSERT_EQUAL(-1, match(&r, "/files").route);
+}
+
+void backtracking(void)
+{
+    furi_router r = furi_make_router(nodes, 128);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/a/b/c", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/:x/b/d", 1));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/a/:y/e", 2));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/a/c/*rest", 3));
+
+    furi_router_match m = match(&r, "/a/b/c");
+    TEST_ASSERT_EQUAL(0, m.route);
+    TEST_ASSERT_EQUAL(0, m.num_captures);
+
+    m = match(&r, "/a/b/d");
+    TEST_ASSERT_EQUAL(1, m.route);
+    TEST_ASSERT_EQUAL(1, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("a", m.captures[0]);
+
+    m = match(&r, "/a/b/e");
+    TEST_ASSERT_EQUAL(2, m.route);
+    TEST_ASSERT_EQUAL(1, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("b", m.captures[0]);
+
+    m = match(&r, "/a/c/f/g");
+    TEST_ASSERT_EQUAL(3, m.route);
+    TEST_ASSERT_EQUAL(1, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("f/g", m.captures[0]);
+
+    m = match(&r, "/a/b/f");
+    TEST_ASSERT_EQUAL(-1, m.route);
+    TEST_ASSERT_EQUAL(0, m.num_captures);
+
+    TEST_ASSERT_EQUAL(-1, match(&r, "/x/b/c").route);
+}
+
+void invalid(void)
+{
+    furi_router r = furi_make_router(nodes, 128);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_INVALID_PATTERN, add(&r, "/a/*x/b", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_INVALID_PATTERN, add(&r, "/*/", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_INVALID_PATTERN, add(&r, "/:a/:b/:c/:d/:e/:f/:g/:h/:i", 0));
+    TEST_ASSERT_EQUAL(1, r.size); // nothing added
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/:a/:b/:c/:d/:e/:f/:g/*h", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/a*/b:", 1)); // not at the beginning of a segment
+
+    furi_router_match m = match(&r, "/1/2/3/4/5/6/7/8/9");
+    TEST_ASSERT_EQUAL(0, m.route);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_MAX_CAPTURES, m.num_captures);
+    TEST_ASSERT_EXPECT_SV("8/9", m.captures[7]);
+    TEST_ASSERT_EQUAL(1, match(&r, "/a*/b:").route);
+
+    r = furi_make_router(nodes, 5);
+    TEST_ASSERT_EQUAL(FURI_ROUTER_OUT_OF_NODES, add(&r, "/a/:b", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_ADDED, add(&r, "/a", 0));
+    TEST_ASSERT_EQUAL(FURI_ROUTER_OUT_OF_NODES, add(&r, "/b", 1));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(static_routes);
+    RUN_TEST(captures);
+    RUN_TEST(backtracking);
+    RUN_TEST(invalid);
+    return UNITY_END();
+}
@@ -0,0 +1,78 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/router.hpp>
+#include <functional>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-router");
+
+TEST_CASE("router")
+{
+    router<std::string> r;
+    CHECK(r.empty());
+    CHECK(r.add("/users/:id", "user") == capi::FURI_ROUTER_ADDED);
+    CHECK(r.add("/users/:user/posts/:post", "post") == capi::FURI_ROUTER_ADDED);
+    CHECK(r.add("/users/me", "me") == capi::FURI_ROUTER_ADDED);
+    CHECK(r.add("/static/*path", "static") == capi::FURI_ROUTER_ADDED);
+    CHECK(r.add("/users/:name", "dup") == capi::FURI_ROUTER_DUPLICATE);
+    CHECK(r.add("/*x/y", "bad") == capi::FURI_ROUTER_INVALID_PATTERN);
+    CHECK(r.size() == 4);
+
+    auto m = r.match("/users/42");
+    REQUIRE(m);
+    CHECK(*m.handler() == "user");
+    CHECK(m.num_captures() == 1);
+    CHECK(m.capture(0) == "42");
+    CHECK(m.capture("id") == "42");
+    CHECK(m.capture("user").null());
+    CHECK(m.capture(1).null());
+
+    m = r.match("/users/me/posts/7");
+    REQUIRE(m);
+    CHECK(*m.handler() == "post");
+    CHECK(m.capture("user") == "me");
+    CHECK(m.capture("post") == "7");
+
+    m = r.match("/users/me");
+    REQUIRE(m);
+    CHECK(*m.handler() == "me");
+    CHECK(m.num_captures() == 0);
+
+    m = r.match("/static/css/site.css");
+    REQUIRE(m);
+    CHECK(m.capture("path") == "css/site.css");
+
+    m = r.match("/nope");
+    CHECK(!m);
+    CHECK(!m.handler());
+    CHECK(m.capture("id").null());
+}
+
+TEST_CASE("router handlers")
+{
+    router<std::function<int(opt_string_view)>> r;
+    std::string pattern = "/double/:n";
+    r.add(pattern, [](opt_string_view n) { return 2 * std::stoi(std::string(n)); });
+    pattern = "overwritten"; // the router keeps its own copy
+    for (int i = 0; i < 100; ++i)
+    {
+        // grow the nodes
+        CHECK(r.add("/r" + std::to_string(i) + "/:x", [i](opt_string_view) { return i; }) == capi::FURI_ROUTER_ADDED);
+    }
+
+    auto m = r.match("/double/21");
+    REQUIRE(m);
+    CHECK((*m.handler())(m.capture("n")) == 42);
+
+    m = r.match("/r57/x");
+    REQUIRE(m);
+    CHECK((*m.handler())(m.capture("x")) == 57);
+
+    auto s = uri_split::from_uri("http://example.com/double/5?x=1");
+    m = r.match(s.path);
+    REQUIRE(m);
+    CHECK((*m.handler())(m.capture(0)) == 10);
+}
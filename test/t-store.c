@@ -0,0 +1,144 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/store.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+#define TEST_ASSERT_NULL_SV(sv) TEST_ASSERT_TRUE(furi_sv_is_null(sv))
+
+static furi_uri_store_entry entries[16];
+static furi_uri_store_page pages[4];
+static char page_data[4][64];
+
+static furi_uri_store_add_result add(furi_uri_store* s, const char* uri, uint32_t* handle)
+{
+    return furi_uri_store_add(s, furi_make_sv_from_string(uri), handle);
+}
+
+void add_and_get(void)
+{
+    furi_uri_store s = furi_make_uri_store(entries, 16, pages, 4);
+    uint32_t h = 0;
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_OUT_OF_PAGE_SPACE, add(&s, "http://a.com", &h));
+    TEST_ASSERT_TRUE(furi_uri_store_add_page(&s, page_data[0], 64));
+
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://x.com:43/abc?xyz#top", &h));
+    TEST_ASSERT_EQUAL(0, h);
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "mailto:me@example.com", &h));
+    TEST_ASSERT_EQUAL(1, h);
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "", &h));
+    TEST_ASSERT_EQUAL(2, h);
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, furi_uri_store_add(&s, FURI_EMPTY_T(furi_sv), &h));
+    TEST_ASSERT_EQUAL(3, h);
+    TEST_ASSERT_EQUAL(4, s.size);
+    TEST_ASSERT_EQUAL(48, pages[0].used); // the texts are back to back
+
+    TEST_ASSERT_EXPECT_SV("http://x.com:43/abc?xyz#top", furi_uri_store_get_uri(&s, 0));
+    TEST_ASSERT_EQUAL_PTR(page_data[0], furi_uri_store_get_uri(&s, 0).begin);
+    furi_uri_split split = furi_uri_store_get_split(&s, 0);
+    TEST_ASSERT_EXPECT_SV("http", split.scheme);
+    TEST_ASSERT_EXPECT_SV("x.com:43", split.authority);
+    TEST_ASSERT_EXPECT_SV("/abc", split.path);
+    TEST_ASSERT_EXPECT_SV("xyz", split.query);
+    TEST_ASSERT_EXPECT_SV("top", split.fragment);
+    TEST_ASSERT_EXPECT_SV("/abc?xyz#top", split.req_path);
+
+    split = furi_uri_store_get_split(&s, 1);
+    TEST_ASSERT_EXPECT_SV("mailto", split.scheme);
+    TEST_ASSERT_NULL_SV(split.authority);
+    TEST_ASSERT_EXPECT_SV("me@example.com", split.path);
+    TEST_ASSERT_NULL_SV(split.query);
+    TEST_ASSERT_EXPECT_SV("me@example.com", furi_uri_store_get(&s, 1, FURI_URI_PATH));
+
+    split = furi_uri_store_get_split(&s, 2);
+    TEST_ASSERT_EXPECT_SV("", split.path);
+    TEST_ASSERT_NULL_SV(split.scheme);
+
+    split = furi_uri_store_get_split(&s, 3);
+    TEST_ASSERT_NULL_SV(split.path);
+    TEST_ASSERT_NULL_SV(split.req_path);
+
+    TEST_ASSERT_TRUE(furi_uri_store_contains(&s, 3));
+    TEST_ASSERT_FALSE(furi_uri_store_contains(&s, 4));
+}
+
+void pages_and_limits(void)
+{
+    furi_uri_store s = furi_make_uri_store(entries, 5, pages, 2);
+    uint32_t h = 0;
+    TEST_ASSERT_TRUE(furi_uri_store_add_page(&s, page_data[0], 20));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://a.com/1", &h));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_OUT_OF_PAGE_SPACE, add(&s, "http://a.com/2", &h));
+    TEST_ASSERT_TRUE(furi_uri_store_add_page(&s, page_data[1], 64));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://a.com/2", &h));
+    TEST_ASSERT_EQUAL(1, h);
+    TEST_ASSERT_EQUAL(1, entries[1].page);
+    TEST_ASSERT_FALSE(furi_uri_store_add_page(&s, page_data[2], 64));
+
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://a.com/3", &h));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://a.com/4", &h));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://a.com/5", &h));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_OUT_OF_ENTRIES, add(&s, "http://a.com/6", &h));
+    TEST_ASSERT_EQUAL(0, pages[0].first);
+    TEST_ASSERT_EQUAL(1, pages[0].end);
+    TEST_ASSERT_EQUAL(1, pages[1].first);
+    TEST_ASSERT_EQUAL(5, pages[1].end);
+
+    static char long_uri[FURI_URI_STORE_MAX_LENGTH + 2];
+    memset(long_uri, 'a', sizeof(long_uri) - 1);
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_TOO_LONG, add(&s, long_uri, &h));
+}
+
+void release_and_iterate(void)
+{
+    furi_uri_store s = furi_make_uri_store(entries, 16, pages, 4);
+    uint32_t h = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT_TRUE(furi_uri_store_add_page(&s, page_data[i], 32));
+        TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "http://a.com/x", &h));
+        TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "/y", &h));
+    }
+
+    uint32_t n = 0;
+    for (uint32_t i = furi_uri_store_first(&s); i < s.size; i = furi_uri_store_next(&s, i)) ++n;
+    TEST_ASSERT_EQUAL(6, n);
+
+    TEST_ASSERT_EQUAL_PTR(page_data[0], furi_uri_store_release_page(&s, 0));
+    TEST_ASSERT_NULL(furi_uri_store_release_page(&s, 0));
+    TEST_ASSERT_EQUAL_PTR(page_data[2], furi_uri_store_release_page(&s, 2));
+    TEST_ASSERT_FALSE(furi_uri_store_contains(&s, 0));
+    TEST_ASSERT_FALSE(furi_uri_store_contains(&s, 1));
+    TEST_ASSERT_TRUE(furi_uri_store_contains(&s, 2));
+    TEST_ASSERT_FALSE(furi_uri_store_contains(&s, 5));
+
+    uint32_t handles[6];
+    n = 0;
+    for (uint32_t i = furi_uri_store_first(&s); i < s.size; i = furi_uri_store_next(&s, i)) handles[n++] = i;
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_EQUAL(2, handles[0]);
+    TEST_ASSERT_EQUAL(3, handles[1]);
+    TEST_ASSERT_EXPECT_SV("/y", furi_uri_store_get(&s, 3, FURI_URI_PATH));
+
+    // the last page was released so new uris need a new page
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_OUT_OF_PAGE_SPACE, add(&s, "/z", &h));
+    TEST_ASSERT_TRUE(furi_uri_store_add_page(&s, page_data[3], 32));
+    TEST_ASSERT_EQUAL(FURI_URI_STORE_ADDED, add(&s, "/z", &h));
+    TEST_ASSERT_EQUAL(6, h);
+    TEST_ASSERT_EQUAL(6, furi_uri_store_next(&s, 3));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(add_and_get);
+    RUN_TEST(pages_and_limits);
+    RUN_TEST(release_and_iterate);
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/store.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-store");
+
+TEST_CASE("uri_store")
+{
+    uri_store s(256);
+    std::vector<uri_store::handle> handles;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto h = s.add("https://example.com/page/" + std::to_string(i) + "?ref=" + std::to_string(i * 2));
+        REQUIRE(h);
+        CHECK(*h == uint32_t(i));
+        handles.push_back(*h);
+    }
+    CHECK(s.size() == 100);
+    CHECK(s.num_pages() > 1);
+
+    // the views are valid after the tables grow
+    auto first = s.split(0);
+    for (int i = 0; i < 2000; ++i) s.add("/x");
+    CHECK(first.path == "/page/0");
+    CHECK(s.split(0).path.data() == first.path.data());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto split = s.split(handles[size_t(i)]);
+        CHECK(split.scheme == "https");
+        CHECK(split.authority == "example.com");
+        CHECK(split.path == "/page/" + std::to_string(i));
+        CHECK(split.query == "ref=" + std::to_string(i * 2));
+        CHECK(s.get(handles[size_t(i)], capi::FURI_URI_QUERY) == split.query);
+    }
+
+    // uris longer than a page get a page of their own
+    std::string long_uri = "http://a.com/" + std::string(1000, 'a');
+    auto lh = s.add(long_uri);
+    REQUIRE(lh);
+    CHECK(s.str(*lh) == long_uri);
+    auto [lfirst, lend] = s.page_handles(s.page_of(*lh));
+    CHECK(lfirst == *lh);
+    CHECK(lend == *lh + 1);
+
+    CHECK_FALSE(s.add(std::string(uri_store::max_uri_length + 1, 'a')));
+}
+
+TEST_CASE("uri_store pages")
+{
+    uri_store s(64);
+    for (int i = 0; i < 20; ++i) s.add("http://a.com/" + std::to_string(i));
+
+    // release all pages with the first 10 uris
+    size_t released = 0;
+    while (s.page_handles(released).second <= 10) s.release_page(released++);
+    CHECK(released > 0);
+
+    auto [begin, end] = s.page_handles(released);
+    CHECK(begin <= 10);
+    CHECK(begin > 0);
+    for (uint32_t h = 0; h < begin; ++h) CHECK_FALSE(s.contains(h));
+    for (uint32_t h = begin; h < 20; ++h) CHECK(s.contains(h));
+    CHECK(end > begin);
+
+    std::vector<uri_store::handle> live;
+    s.for_each([&](uri_store::handle h, const uri_split& split) {
+        CHECK(split.path == "/" + std::to_string(h));
+        live.push_back(h);
+    });
+    CHECK(live.size() == 20 - begin);
+    CHECK(live.front() == begin);
+    CHECK(live.back() == 19);
+}
+
+namespace
+{
+uri_store make_store()
+{
+    uri_store s(64);
+    for (int i = 0; i < 20; ++i) s.add("http://a.com/" + std::to_string(i));
+    return s;
+}
+}
+
+TEST_CASE("uri_store move")
+{
+    static_assert(std::is_nothrow_move_constructible_v<uri_store>);
+    static_assert(std::is_nothrow_move_assignable_v<uri_store>);
+
+    auto s = make_store();
+    REQUIRE(s.size() == 20);
+    auto view = s.str(7);
+
+    uri_store m(std::move(s));
+    CHECK(m.size() == 20);
+    CHECK(m.str(7) == "http://a.com/7");
+    CHECK(m.str(7).data() == view.data()); // the pages weren't copied
+    CHECK(m.split(19).path == "/19");
+
+    // the moved-from store is empty and usable
+    CHECK(s.size() == 0);
+    CHECK(s.num_pages() == 0);
+    auto h = s.add("http://b.com/x");
+    REQUIRE(h);
+    CHECK(*h == 0);
+    CHECK(s.split(*h).authority == "b.com");
+
+    std::optional<uri_store> opt;
+    opt = std::move(m);
+    opt = make_store();
+    CHECK(opt->str(3) == "http://a.com/3");
+    opt = std::move(s);
+    CHECK(opt->size() == 1);
+    CHECK(opt->str(0) == "http://b.com/x");
+    CHECK(opt->add("http://c.com/"));
+    CHECK(opt->str(1) == "http://c.com/");
+}
@@ -0,0 +1,266 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <unity.h>
+
+#include <furi/suffix.h>
+
+#include <stdio.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_ASSERT_SV_EQUAL(a, b) TEST_ASSERT(furi_sv_cmp(a, b) == 0)
+#define TEST_ASSERT_EXPECT_SV(expected, sv) TEST_ASSERT_SV_EQUAL(furi_make_sv_from_string(expected), sv)
+
+static const char* psl_rules[] = {
+    "com", "uk", "co.uk", "*.ck", "!www.ck", "jp", "ac.jp", "*.kobe.jp", "!city.kobe.jp",
+};
+#define NUM_PSL_RULES (sizeof(psl_rules) / sizeof(psl_rules[0]))
+
+static furi_sv rules[64];
+static uint32_t scratch[64];
+static furi_suffix_node nodes[256];
+static char chars[1024];
+static furi_suffix_trie trie;
+
+static furi_suffix_build_result build(const char* const* strs, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) rules[i] = furi_make_sv_from_string(strs[i]);
+    return furi_build_suffix_trie(rules, n, scratch, nodes, 256, chars, 1024, &trie);
+}
+
+// suffix and domain are NULL for null
+static void test_match(const furi_suffix_trie* t, const char* host, const char* suffix, const char* domain)
+{
+    furi_suffix_match m = furi_suffix_trie_match(t, furi_make_sv_from_string(host));
+    TEST_ASSERT_EQUAL(!suffix, m.rule == FURI_SUFFIX_NONE);
+    if (suffix) TEST_ASSERT_EXPECT_SV(suffix, m.suffix);
+    else TEST_ASSERT_NULL(m.suffix.begin);
+    if (domain) TEST_ASSERT_EXPECT_SV(domain, m.domain);
+    else TEST_ASSERT_NULL(m.domain.begin);
+}
+
+static void test_psl(const furi_suffix_trie* t)
+{
+    test_match(t, "www.example.com", "com", "example.com");
+    test_match(t, "example.com", "com", "example.com");
+    test_match(t, "com", "com", NULL);
+    test_match(t, "www.example.com.", "com", "example.com");
+    test_match(t, "EXAMPLE.CO.UK", "CO.UK", "EXAMPLE.CO.UK");
+    test_match(t, "b.example.co.uk", "co.uk", "example.co.uk");
+    test_match(t, "co.uk", "co.uk", NULL);
+    test_match(t, "test.ck", "test.ck", NULL);
+    test_match(t, "b.test.ck", "test.ck", "b.test.ck");
+    test_match(t, "www.ck", "ck", "www.ck");
+    test_match(t, "a.www.ck", "ck", "www.ck");
+    test_match(t, "c.kobe.jp", "c.kobe.jp", NULL);
+    test_match(t, "b.c.kobe.jp", "c.kobe.jp", "b.c.kobe.jp");
+    test_match(t, "city.kobe.jp", "kobe.jp", "city.kobe.jp");
+    test_match(t, "www.City.Kobe.JP", "Kobe.JP", "City.Kobe.JP");
+    test_match(t, "x.ac.jp", "ac.jp", "x.ac.jp");
+    test_match(t, "example.org", NULL, NULL);
+    test_match(t, "", NULL, NULL);
+    test_match(t, ".", NULL, NULL);
+    test_match(t, "a..com", "com", ".com");
+}
+
+void rule_validation(void)
+{
+    const char* valid[] = {"com", "co.uk", "*.ck", "!www.ck", "*", "xn--p1ai", "a.b.c.d"};
+    const char* invalid[] = {"", "!", ".com", "com.", "a..b", "!com", "*.*.ck", "a.*.ck", "!*.ck", "a*.ck"};
+    for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i)
+    {
+        TEST_ASSERT_TRUE(furi_suffix_rule_is_valid(furi_make_sv_from_string(valid[i])));
+    }
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+    {
+        TEST_ASSERT_FALSE(furi_suffix_rule_is_valid(furi_make_sv_from_string(invalid[i])));
+    }
+}
+
+void psl(void)
+{
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_BUILT, build(psl_rules, NUM_PSL_RULES));
+    test_psl(&trie);
+
+    furi_suffix_match m = furi_suffix_trie_match(&trie, furi_make_sv_from_string("a.b.example.co.uk"));
+    TEST_ASSERT_EQUAL_UINT32(2, m.rule);
+    m = furi_suffix_trie_match(&trie, furi_make_sv_from_string("www.ck"));
+    TEST_ASSERT_EQUAL_UINT32(4, m.rule);
+    m = furi_suffix_trie_match(&trie, furi_make_sv_from_string("x.ck"));
+    TEST_ASSERT_EQUAL_UINT32(3, m.rule);
+
+    // with the implicit rule
+    const char* with_star[] = {"com", "*", "co.uk"};
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_BUILT, build(with_star, 3));
+    test_match(&trie, "example.org", "org", "example.org");
+    test_match(&trie, "a.example.co.uk", "co.uk", "example.co.uk");
+    test_match(&trie, "org", "org", NULL);
+}
+
+void domain_suffix(void)
+{
+    // per-domain settings
+    const char* domains[] = {"example.com", "api.example.com", "example.org"};
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_BUILT, build(domains, 3));
+    test_match(&trie, "www.example.com", "example.com", "www.example.com");
+    test_match(&trie, "v1.api.example.com", "api.example.com", "v1.api.example.com");
+    test_match(&trie, "example.com", "example.com", NULL);
+    test_match(&trie, "xexample.com", NULL, NULL);
+    test_match(&trie, "com", NULL, NULL);
+    furi_suffix_match m = furi_suffix_trie_match(&trie, furi_make_sv_from_string("EXAMPLE.org"));
+    TEST_ASSERT_EQUAL_UINT32(2, m.rule);
+}
+
+void build_errors(void)
+{
+    const char* invalid[] = {"com", "a..b"};
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_INVALID_RULE, build(invalid, 2));
+    const char* dup[] = {"co.uk", "uk", "CO.uk"};
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_DUPLICATE, build(dup, 3));
+    const char* dup_exception[] = {"*.ck", "www.ck", "!www.ck"};
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_DUPLICATE, build(dup_exception, 3));
+
+    const char* three[] = {"a.b", "c.b", "d"};
+    for (uint32_t i = 0; i < 3; ++i) rules[i] = furi_make_sv_from_string(three[i]);
+    TEST_ASSERT_EQUAL_UINT32(6, furi_suffix_trie_max_nodes(rules, 3));
+    TEST_ASSERT_EQUAL_UINT32(7, furi_suffix_trie_max_chars(rules, 3));
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_OUT_OF_NODES, furi_build_suffix_trie(rules, 3, scratch, nodes, 4, chars, 7, &trie));
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_OUT_OF_CHARS, furi_build_suffix_trie(rules, 3, scratch, nodes, 6, chars, 3, &trie));
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_BUILT, furi_build_suffix_trie(rules, 3, scratch, nodes, 5, chars, 4, &trie));
+    TEST_ASSERT_EQUAL_UINT32(5, trie.num_nodes); // "b" is shared
+    TEST_ASSERT_EQUAL_UINT32(4, trie.num_chars);
+}
+
+void blob(void)
+{
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_BUILT, build(psl_rules, NUM_PSL_RULES));
+    static uint32_t data[1024];
+    size_t size = furi_suffix_trie_blob_size(&trie);
+    TEST_ASSERT_TRUE(size <= sizeof(data));
+    furi_suffix_trie_write_blob(&trie, data);
+
+    furi_suffix_trie loaded;
+    TEST_ASSERT_TRUE(furi_suffix_trie_from_blob(data, size, &loaded));
+    TEST_ASSERT_EQUAL_UINT32(trie.num_nodes, loaded.num_nodes);
+    TEST_ASSERT_EQUAL_UINT32(trie.num_chars, loaded.num_chars);
+    test_psl(&loaded);
+
+    TEST_ASSERT_FALSE(furi_suffix_trie_from_blob(data, size - 1, &loaded));
+    TEST_ASSERT_FALSE(furi_suffix_trie_from_blob(data, 8, &loaded));
+
+    furi_suffix_node* blob_nodes = (furi_suffix_node*)(data + 4);
+    uint32_t children = blob_nodes[1].children;
+    blob_nodes[1].children = 0; // a cycle
+    TEST_ASSERT_FALSE(furi_suffix_trie_from_blob(data, size, &loaded));
+    blob_nodes[1].children = children;
+    uint32_t label = blob_nodes[2].label;
+    blob_nodes[2].label = trie.num_chars;
+    TEST_ASSERT_FALSE(furi_suffix_trie_from_blob(data, size, &loaded));
+    blob_nodes[2].label = label;
+    uint16_t num_children = blob_nodes[0].num_children;
+    children = blob_nodes[0].children;
+    blob_nodes[0].num_children = UINT16_MAX; // more children than nodes
+    blob_nodes[0].children = 1;
+    TEST_ASSERT_FALSE(furi_suffix_trie_from_blob(data, size, &loaded));
+    blob_nodes[0].num_children = num_children;
+    blob_nodes[0].children = children;
+    TEST_ASSERT_TRUE(furi_suffix_trie_from_blob(data, size, &loaded));
+    data[0] = 0;
+    TEST_ASSERT_FALSE(furi_suffix_trie_from_blob(data, size, &loaded));
+}
+
+// the public suffix list algorithm on all rules
+static furi_suffix_match naive_match(const char* const* strs, uint32_t n, furi_sv host)
+{
+    furi_suffix_match ret = {FURI_SUFFIX_NONE, {0}, {0}};
+    uint32_t best_labels = 0;
+    bool best_exception = false, best_wildcard = false;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        furi_sv rule = furi_make_sv_from_string(strs[i]);
+        furi_sv labels = furi_suffix_rule_labels(rule);
+        bool exception = labels.begin != rule.begin;
+        furi_host_label_iter ri = furi_make_host_label_iter_begin(labels);
+        furi_host_label_iter hi = furi_make_host_label_iter_begin(host);
+        uint32_t count = 0;
+        bool wildcard = false;
+        for (; !furi_host_label_iter_is_done(ri); furi_host_label_iter_next(&ri), furi_host_label_iter_next(&hi), ++count)
+        {
+            if (furi_host_label_iter_is_done(hi)) break;
+            furi_sv rl = furi_host_label_iter_get_value(ri);
+            wildcard = furi_suffix_is_wildcard(rl);
+            if (!wildcard && !furi_sv_iequals(rl, furi_host_label_iter_get_value(hi))) break;
+        }
+        if (!furi_host_label_iter_is_done(ri)) continue;
+
+        bool better = exception != best_exception ? exception
+            : count != best_labels ? count > best_labels
+            : best_wildcard && !wildcard;
+        if (ret.rule != FURI_SUFFIX_NONE && !better) continue;
+        ret.rule = i;
+        best_labels = count;
+        best_exception = exception;
+        best_wildcard = wildcard;
+    }
+    if (ret.rule == FURI_SUFFIX_NONE) return ret;
+
+    uint32_t suffix_labels = best_exception ? best_labels - 1 : best_labels;
+    furi_host_label_iter hi = furi_make_host_label_iter_begin(host);
+    const char* end = hi.end;
+    for (uint32_t i = 1; i < suffix_labels; ++i) furi_host_label_iter_next(&hi);
+    ret.suffix = furi_make_sv(hi.begin, end);
+    furi_host_label_iter_next(&hi);
+    if (!furi_host_label_iter_is_done(hi)) ret.domain = furi_make_sv(hi.begin, end);
+    return ret;
+}
+
+void against_naive(void)
+{
+    static const char* all_rules[] = {
+        "com", "uk", "co.uk", "*.ck", "!www.ck", "jp", "ac.jp", "*.kobe.jp", "!city.kobe.jp",
+        "b.a.com", "*.b.com", "x.co.uk", "*.jp",
+    };
+    const uint32_t num_rules = sizeof(all_rules) / sizeof(all_rules[0]);
+    TEST_ASSERT_EQUAL(FURI_SUFFIX_BUILT, build(all_rules, num_rules));
+
+    const char* labels[] = {"a", "b", "co", "uk", "ck", "WWW", "kobe", "city", "jp", "x", "com", "ac"};
+    const uint32_t num_labels = sizeof(labels) / sizeof(labels[0]);
+    char host[64];
+    uint32_t total = num_labels * num_labels * num_labels * num_labels;
+    for (uint32_t n = 0; n < total; ++n)
+    {
+        // 1-4 labels
+        char* p = host;
+        uint32_t x = n;
+        uint32_t count = 1 + n % 4;
+        for (uint32_t i = 0; i < count; ++i, x /= num_labels)
+        {
+            if (i) *p++ = '.';
+            size_t len = strlen(labels[x % num_labels]);
+            memcpy(p, labels[x % num_labels], len);
+            p += len;
+        }
+        furi_sv h = furi_make_sv(host, p);
+        furi_suffix_match m = furi_suffix_trie_match(&trie, h);
+        furi_suffix_match e = naive_match(all_rules, num_rules, h);
+        TEST_ASSERT_EQUAL_UINT32(e.rule, m.rule);
+        TEST_ASSERT_EQUAL_PTR(e.suffix.begin, m.suffix.begin);
+        TEST_ASSERT_EQUAL_PTR(e.suffix.end, m.suffix.end);
+        TEST_ASSERT_EQUAL_PTR(e.domain.begin, m.domain.begin);
+        TEST_ASSERT_EQUAL_PTR(e.domain.end, m.domain.end);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(rule_validation);
+    RUN_TEST(psl);
+    RUN_TEST(domain_suffix);
+    RUN_TEST(build_errors);
+    RUN_TEST(blob);
+    RUN_TEST(against_naive);
+    return UNITY_END();
+}
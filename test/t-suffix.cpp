@@ -0,0 +1,51 @@
+// Copyright (c) Borislav Stanimirov
+// SPDX-License-Identifier: MIT
+//
+#include <doctest/doctest.h>
+#include <furi/suffix.hpp>
+#include <string>
+
+using namespace furi;
+
+TEST_SUITE_BEGIN("furi-suffix");
+
+TEST_CASE("suffix_trie")
+{
+    suffix_trie trie;
+    CHECK(trie.empty());
+    CHECK(!trie.match("example.com"));
+
+    std::vector<std::string> owned = {"com", "co.uk", "uk", "*.ck", "!www.ck"};
+    CHECK(trie.build({owned.begin(), owned.end()}) == capi::FURI_SUFFIX_BUILT);
+    owned.clear(); // the trie has its own copies
+
+    auto m = trie.match("a.b.Example.co.uk");
+    CHECK(m);
+    CHECK(m.rule == 1);
+    CHECK(m.suffix == "co.uk");
+    CHECK(m.domain == "Example.co.uk");
+
+    m = trie.match("shop.www.ck");
+    CHECK(m.rule == 4);
+    CHECK(m.suffix == "ck");
+    CHECK(m.domain == "www.ck");
+
+    m = trie.match("uk");
+    CHECK(m.suffix == "uk");
+    CHECK(!m.domain);
+
+    CHECK(!trie.match("example.org"));
+
+    auto blob = trie.blob();
+    suffix_trie loaded;
+    CHECK(loaded.load(blob.data(), blob.size()));
+    CHECK(loaded.size() == trie.size());
+    CHECK(loaded.match("a.b.example.co.uk").domain == "example.co.uk");
+    CHECK(loaded.match("x.y.ck").domain == "x.y.ck");
+
+    CHECK(!loaded.load(blob.data(), blob.size() - 1));
+    CHECK(loaded.empty());
+
+    CHECK(trie.build({"com", "a..com"}) == capi::FURI_SUFFIX_INVALID_RULE);
+    CHECK(trie.empty());
+}